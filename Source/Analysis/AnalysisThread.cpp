@@ -0,0 +1,117 @@
+#include "AnalysisThread.h"
+
+//==============================================================================
+// Implementation for the AnalysisThread class
+AnalysisThread::AnalysisThread() : juce::Thread("MultiMeter Analysis")
+{
+    ringBuffer.clear();
+    chunk.clear();
+}
+
+AnalysisThread::~AnalysisThread()
+{
+    stopThread(1000);
+}
+
+void AnalysisThread::addAnalysis(StereoAnalysis& analysis)
+{
+    jassert(!isThreadRunning());
+    analyses.push_back(&analysis);
+    wasWanted.push_back(false);
+}
+
+void AnalysisThread::prepare(double sampleRate)
+{
+    // The analyses are only touched by this thread, so it is stopped while they are prepared
+    stopThread(1000);
+
+    currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    ring.reset();
+
+    for (size_t index = 0; index < analyses.size(); ++index)
+    {
+        analyses[index]->prepare(currentSampleRate);
+        wasWanted[index] = analyses[index]->interest.isWanted();
+    }
+
+    startThread();
+}
+
+void AnalysisThread::push(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    // Nothing is copied while no view shows any of the analyses
+    if (std::none_of(analyses.begin(), analyses.end(), [](const StereoAnalysis* analysis) { return analysis->interest.isWanted(); }))
+        return;
+
+    // A mono input is written to both sides
+    const int rightChannel = juce::jmin(1, numChannels - 1);
+    const int numSamples = juce::jmin(buffer.getNumSamples(), ring.getFreeSpace());
+
+    int start1, size1, start2, size2;
+    ring.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+    {
+        ringBuffer.copyFrom(0, start1, buffer, 0, 0, size1);
+        ringBuffer.copyFrom(1, start1, buffer, rightChannel, 0, size1);
+    }
+
+    if (size2 > 0)
+    {
+        ringBuffer.copyFrom(0, start2, buffer, 0, size1, size2);
+        ringBuffer.copyFrom(1, start2, buffer, rightChannel, size1, size2);
+    }
+
+    ring.finishedWrite(size1 + size2);
+}
+
+void AnalysisThread::run()
+{
+    while (!threadShouldExit())
+    {
+        // Drain the ring chunk by chunk, then sleep until more audio has arrived
+        while (ring.getNumReady() > 0 && !threadShouldExit())
+        {
+            ScopedTraceEvent chunkEvent("analysis", "Analysis chunk");
+            const int numSamples = juce::jmin(chunkSize, ring.getNumReady());
+
+            {
+                ScopedTraceEvent pullEvent("fifo", "Analysis ring pull");
+
+                int start1, size1, start2, size2;
+                ring.prepareToRead(numSamples, start1, size1, start2, size2);
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    if (size1 > 0)
+                        chunk.copyFrom(channel, 0, ringBuffer, channel, start1, size1);
+                    if (size2 > 0)
+                        chunk.copyFrom(channel, size1, ringBuffer, channel, start2, size2);
+                }
+
+                ring.finishedRead(size1 + size2);
+            }
+
+            for (size_t index = 0; index < analyses.size(); ++index)
+            {
+                auto* analysis = analyses[index];
+                const bool isWanted = analysis->interest.isWanted();
+
+                // Start from a clean state when a view comes back
+                if (isWanted && !wasWanted[index])
+                    analysis->prepare(currentSampleRate);
+
+                wasWanted[index] = isWanted;
+
+                if (isWanted)
+                    analysis->process(chunk.getReadPointer(0), chunk.getReadPointer(1), numSamples);
+            }
+        }
+
+        wait(waitIntervalMs);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ViewInterest.h"
+#include "../Profiling/TraceRecorder.h"
+
+//==============================================================================
+// Work that runs on the analysis thread over the stereo samples of the audio thread
+struct StereoAnalysis
+{
+    virtual ~StereoAnalysis() = default;
+
+    // Called before the first samples at a new sample rate, either from prepareToPlay on the
+    // caller's thread while the analysis thread is stopped, or on the analysis thread when a
+    // view comes back
+    virtual void prepare(double sampleRate) = 0;
+
+    // Called on the analysis thread with consecutive chunks of samples
+    virtual void process(const float* left, const float* right, int numSamples) = 0;
+
+    // Views showing the output. The analysis is skipped while none is registered, and
+    // prepared again before it resumes, so it never continues from stale state.
+    ViewInterest interest;
+};
+
+//==============================================================================
+// Background thread for analyses that are too heavy or too bursty for the audio
+// thread but must still see every sample. The audio thread copies each block into
+// a lock-free stereo ring, and the analysis thread drains it in fixed-size chunks
+// and hands them to every registered StereoAnalysis that some view is showing. While no
+// view shows any of them, the audio thread does not copy anything. If the thread falls
+// behind, samples that do not fit into the ring are dropped rather than blocking the audio.
+class AnalysisThread : public juce::Thread
+{
+public:
+    static constexpr int ringCapacity = 1 << 16; // Stereo frames held by the ring, about 340 ms at 192 kHz
+    static constexpr int chunkSize = 512; // Frames handed to the analyses at a time
+    static constexpr int waitIntervalMs = 5; // Time the thread sleeps when the ring is empty
+
+    AnalysisThread();
+    ~AnalysisThread() override;
+
+    // Registers an analysis, only allowed before the first call to prepare
+    void addAnalysis(StereoAnalysis& analysis);
+
+    // Prepares every analysis for the given sample rate and (re)starts the thread, called from prepareToPlay
+    void prepare(double sampleRate);
+
+    // Copies the samples of the buffer into the ring when an analysis is wanted, called from processBlock
+    void push(const juce::AudioBuffer<float>& buffer);
+
+    // Drains the ring until the thread is asked to stop
+    void run() override;
+
+    // Returns the number of stereo frames waiting in the ring, safe to call from any thread
+    int getNumQueuedFrames() const { return ring.getNumReady(); }
+
+private:
+    juce::AbstractFifo ring { ringCapacity }; // Read and write positions of the ring
+    juce::AudioBuffer<float> ringBuffer { 2, ringCapacity }; // Sample storage of the ring
+    juce::AudioBuffer<float> chunk { 2, chunkSize }; // Contiguous copy handed to the analyses
+    std::vector<StereoAnalysis*> analyses; // Registered analyses, processed in order
+    std::vector<bool> wasWanted; // Whether each analysis was wanted for the previous chunk
+    double currentSampleRate = 44100.0; // Sample rate the analyses are prepared for
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisThread)
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// The two latest frames of an analysis and the times they describe, so a display
+// running faster than the analysis can move smoothly between them. The display is
+// one analysis interval behind: it shows the previous frame when the latest one
+// arrives and reaches the latest one an interval later. Frames that arrive about as
+// often as the display refreshes are shown as they are, without the added latency, and
+// so are frames after a pause, such as a stopped transport.
+template <typename FrameType>
+struct FrameInterpolator
+{
+    static constexpr double maxIntervalMs = 250.0; // Longest gap between frames that is interpolated
+
+    // Adds the latest frame, describing the signal at the given time in milliseconds
+    void push(const FrameType& frame, double timeMs)
+    {
+        std::swap(previous, latest);
+        previousTimeMs = latestTimeMs;
+        latest = frame;
+        latestTimeMs = timeMs;
+        numFrames = juce::jmin(numFrames + 1, 2);
+    }
+
+    // Returns how far the display has moved from the previous towards the latest frame at the
+    // given time, from 0 to 1, for a display that refreshes every displayPeriodMs
+    float getProportion(double timeMs, double displayPeriodMs) const
+    {
+        const double interval = latestTimeMs - previousTimeMs;
+        if (numFrames < 2 || interval <= 1.5 * displayPeriodMs || interval > maxIntervalMs)
+            return 1.f;
+
+        return static_cast<float>(juce::jlimit(0.0, 1.0, (timeMs - latestTimeMs) / interval));
+    }
+
+    // Returns the previous and the latest frame
+    const FrameType& getPrevious() const { return previous; }
+    const FrameType& getLatest() const { return latest; }
+
+    // Returns whether a frame has been added since the last reset
+    bool hasFrame() const { return numFrames > 0; }
+
+    // Forgets the frames, so the next one is shown as it is
+    void reset() { numFrames = 0; }
+
+    // Writes the linear interpolation of two series of values at the given proportion
+    static void interpolate(const float* previousValues, const float* latestValues, float proportion, float* destination, int numValues)
+    {
+        juce::FloatVectorOperations::copy(destination, latestValues, numValues);
+        if (proportion >= 1.f)
+            return;
+
+        juce::FloatVectorOperations::subtract(destination, previousValues, numValues);
+        juce::FloatVectorOperations::multiply(destination, proportion, numValues);
+        juce::FloatVectorOperations::add(destination, previousValues, numValues);
+    }
+
+private:
+    FrameType previous {}; // Frame before the latest one
+    FrameType latest {}; // Latest frame
+    double previousTimeMs = 0.0; // Time described by the previous frame
+    double latestTimeMs = 0.0; // Time described by the latest frame
+    int numFrames = 0; // Number of valid frames, up to two
+};
@@ -0,0 +1,32 @@
+#include "FrameScheduler.h"
+
+//==============================================================================
+// Implementation for the FrameScheduler class
+FrameScheduler::FrameScheduler(const SilenceDetector& detector) :
+    silenceDetector(detector),
+    lastActiveBlockCount(detector.getActiveBlockCount()),
+    lastChangeMs(juce::Time::getMillisecondCounterHiRes())
+{
+}
+
+bool FrameScheduler::update()
+{
+    const auto now = juce::Time::getMillisecondCounterHiRes();
+    const auto activeBlockCount = silenceDetector.getActiveBlockCount();
+
+    // Any audio above the floor or anything drawn restarts the settle time
+    if (activeBlockCount != lastActiveBlockCount || paintedSinceLastTick)
+    {
+        lastActiveBlockCount = activeBlockCount;
+        lastChangeMs = now;
+    }
+
+    paintedSinceLastTick = false;
+
+    const bool shouldIdle = now - lastChangeMs >= settleTimeMs;
+    if (shouldIdle == idle)
+        return false;
+
+    idle = shouldIdle;
+    return true;
+}
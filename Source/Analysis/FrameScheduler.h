@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Constants.h"
+
+//==============================================================================
+// Per-block silence flag of the audio thread. A block is silent when its sample peak is
+// below the floor of every display, so silent input can never change what is drawn.
+// Instead of a flag that could be missed between two GUI frames, the detector counts the
+// blocks that were not silent, and the GUI notices new activity as a change of the count.
+struct SilenceDetector
+{
+    static constexpr float thresholdDb = NEGATIVE_INFINITY; // Block peak below which the input is silent
+
+    // Flags the block from its peak, already measured by the signal statistics, called from processBlock
+    void process(float blockPeak)
+    {
+        if (blockPeak > threshold)
+            activeBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns the number of blocks that were not silent, safe to call from any thread
+    juce::uint32 getActiveBlockCount() const { return activeBlocks.load(std::memory_order_relaxed); }
+
+private:
+    // Threshold as a gain. The floor is passed below the threshold, as the default floor of
+    // -100 dB would turn it into 0 and count any non-zero sample as input.
+    const float threshold = juce::Decibels::decibelsToGain(thresholdDb, thresholdDb - 1.f);
+    std::atomic<juce::uint32> activeBlocks { 0 }; // Number of blocks that were not silent
+};
+
+//==============================================================================
+// Frame rate of the editor. The views run at the full rate while there is input, and the
+// scheduler drops to a slow idle rate once the input has been silent and nothing in the
+// editor has been repainted for the settle time, so the meters have finished decaying and
+// releasing their holds. It returns to the full rate on the first tick that sees a
+// non-silent block or a repaint, for example from the mouse.
+struct FrameScheduler
+{
+    static constexpr int fullRateHz = 60; // Frame rate while the views move
+    static constexpr int idleRateHz = 10; // Rate at which the input is checked while idle
+    static constexpr int minSettleTimeMs = 2000; // Shortest time without input and repaints before idling, longer than the polar hold
+
+    // Constructor with the silence flag of the audio thread
+    explicit FrameScheduler(const SilenceDetector& detector);
+
+    // Updates the state at the start of a timer tick, returns whether the rate changed
+    bool update();
+
+    // Notes that part of the editor was repainted, called from its paint methods
+    void notePaint() { paintedSinceLastTick = true; }
+
+    // Sets the time the views may keep changing after the input fell silent, such as a peak hold
+    void setSettleTime(int milliseconds) { settleTimeMs = juce::jmax(minSettleTimeMs, milliseconds); }
+
+    // Returns whether the views have settled and the editor runs at the idle rate
+    bool isIdle() const { return idle; }
+
+    // Returns the timer rate for the current state
+    int getFrameRateHz() const { return idle ? idleRateHz : fullRateHz; }
+
+private:
+    const SilenceDetector& silenceDetector; // Silence flag of the audio thread
+    juce::uint32 lastActiveBlockCount = 0; // Count of non-silent blocks seen at the previous tick
+    double lastChangeMs = 0; // Time of the latest non-silent block or repaint
+    bool paintedSinceLastTick = false; // Flag indicating a repaint since the previous tick
+    int settleTimeMs = minSettleTimeMs; // Time without input and repaints before idling
+    bool idle = false; // Flag indicating the idle state
+};
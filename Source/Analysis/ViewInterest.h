@@ -0,0 +1,50 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Number of views currently showing the output of an analysis. Views register while
+// they are visible in an open editor, and the audio and analysis threads skip the work
+// of an analysis that nobody is looking at. The level, loudness and correlation meters
+// are always shown and their analyses do not use this.
+struct ViewInterest
+{
+    // Returns whether at least one view shows the output, safe to call from any thread
+    bool isWanted() const { return numViews.load(std::memory_order_relaxed) > 0; }
+
+    // Registers or unregisters a view, called from the GUI
+    void add() { numViews.fetch_add(1); }
+    void remove() { numViews.fetch_sub(1); }
+
+private:
+    std::atomic<int> numViews { 0 }; // Number of registered views
+};
+
+//==============================================================================
+// Registration of a view with at most one ViewInterest at a time. Switching the target
+// moves the registration, and destroying it (for example when the editor closes) releases it.
+struct InterestRegistration
+{
+    InterestRegistration() = default;
+    ~InterestRegistration() { setTarget(nullptr); }
+
+    // Registers with the given interest instead of the current one, nullptr to unregister
+    void setTarget(ViewInterest* newTarget)
+    {
+        if (newTarget == target)
+            return;
+
+        if (target != nullptr)
+            target->remove();
+
+        if (newTarget != nullptr)
+            newTarget->add();
+
+        target = newTarget;
+    }
+
+private:
+    ViewInterest* target = nullptr; // Interest currently registered with
+
+    JUCE_DECLARE_NON_COPYABLE(InterestRegistration)
+};
@@ -76,6 +76,8 @@ void myLookAndFeel::drawRotarySlider(juce::Graphics& g,
 // Implementation for the RotarySliderWithLabels class
 void RotarySliderWithLabels::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Controls);
+
     using namespace juce;
 
     // Define the start and end angles for the rotary slider
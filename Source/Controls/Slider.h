@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../Constants.h"
+#include "../Profiling/PaintProfiler.h"
 
 using namespace juce;
 
@@ -70,4 +71,5 @@ private:
     myLookAndFeel lnf; // Custom LookAndFeel object
     RangedAudioParameter* param; // Pointer to the associated audio parameter
     String suffix; // Unit suffix
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
@@ -2,19 +2,80 @@
 #include "CorrelationMeter.h"
 
 //==============================================================================
-// Implementation for the CorrelationMeter class
-CorrelationMeter::CorrelationMeter(juce::AudioBuffer<float>& buf, double sampleRate) : buffer(buf)
+// Implementation for the CorrelationAnalyzer class
+void CorrelationAnalyzer::prepare(double sampleRate)
 {
-    // Initialize the filters with low-pass coefficients
-    for (auto& filter : filters)
+    currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    currentSlowTimeConstantMs = slowTimeConstantMs.load();
+
+    const auto fast = BiquadCoefficients::makeOnePole(fastTimeConstantMs, currentSampleRate);
+    const auto slow = BiquadCoefficients::makeOnePole(currentSlowTimeConstantMs, currentSampleRate);
+    for (int lane = 0; lane < 3; ++lane)
+    {
+        integrators.setCoefficients(0, lane, fast);
+        integrators.setCoefficients(0, lane + 3, slow);
+    }
+
+    integrators.reset();
+    outputs.fill(0.f);
+    fastCorrelation.store(0.f);
+    slowCorrelation.store(0.f);
+}
+
+void CorrelationAnalyzer::process(const juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (buffer.getNumChannels() == 0 || numSamples == 0)
+        return;
+
+    // Pick up a new slow time constant from the GUI
+    const auto requestedTimeConstant = slowTimeConstantMs.load();
+    if (requestedTimeConstant != currentSlowTimeConstantMs)
     {
-        auto coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 20000.f);
-        filter.coefficients = coefficients;
+        currentSlowTimeConstantMs = requestedTimeConstant;
+        const auto slow = BiquadCoefficients::makeOnePole(currentSlowTimeConstantMs, currentSampleRate);
+        for (int lane = 3; lane < 6; ++lane)
+            integrators.setCoefficients(0, lane, slow);
     }
+
+    // A mono input is fully correlated with itself
+    auto* left = buffer.getReadPointer(0);
+    auto* right = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
+
+    // All six integrators of a sample run as lanes of one bank
+    IntegratorBank::Frame frame {};
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float l = left[i];
+        const float r = right[i];
+        frame = { l * r, l * l, r * r, l * r, l * l, r * r, 0.f, 0.f };
+        integrators.process(frame);
+    }
+    outputs = frame;
+
+    fastCorrelation.store(getCorrelation(0));
+    slowCorrelation.store(getCorrelation(3));
+}
+
+float CorrelationAnalyzer::getCorrelation(int lane) const
+{
+    const auto denominator = std::sqrt(outputs[lane + 1] * outputs[lane + 2]);
+
+    // Silence has no defined correlation and is shown as 0
+    if (!std::isfinite(denominator) || denominator < 1.0e-9f)
+        return 0.f;
+
+    return juce::jlimit(-1.f, 1.f, outputs[lane] / denominator);
 }
 
+//==============================================================================
+// Implementation for the CorrelationMeter class
+CorrelationMeter::CorrelationMeter(CorrelationAnalyzer& analyzerInput) : analyzer(analyzerInput) {}
+
 void CorrelationMeter::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Correlation);
+
     // Fill the background with the base color
     g.setColour(BASE_COLOR);
     g.fillRoundedRectangle(getLocalBounds().toFloat(), 3);
@@ -22,11 +83,15 @@ void CorrelationMeter::paint(juce::Graphics& g)
     // Divide the area into two parts: slowBounds and fastBounds
     auto slowBounds = getLocalBounds().removeFromTop(getLocalBounds().getHeight() / 3);
 
-    // Draw the average for peakAverager in slowBounds with a border
-    drawAverage(g, slowBounds, peakAverager.getAvg(), true);
+    // Draw the fast correlation in slowBounds with a border
+    drawAverage(g, slowBounds, fastCorrelation, true);
 
-    // Draw the average for slowAverager in fastBounds with a border
-    drawAverage(g, getLocalBounds(), slowAverager.getAvg(), true);
+    // Draw the slow correlation in the whole area with a border
+    drawAverage(g, getLocalBounds(), slowCorrelation, true);
+
+    // Draw the slow correlation readout over the lower part of the bar
+    g.setColour(juce::Colours::white);
+    glyphCache->draw(g, slowCorrelationTenths / 10.f, readoutFont, getReadoutArea(), juce::Justification::centredRight);
 
     // Draw the border around the component
     Path border;
@@ -38,41 +103,50 @@ void CorrelationMeter::paint(juce::Graphics& g)
     g.fillPath(border);
 }
 
-void CorrelationMeter::update(juce::int64 average_time)
+void CorrelationMeter::update()
 {
-    auto numSamples = buffer.getNumSamples();
+    // The correlation is measured on the audio thread, only the readings are copied here
+    const float newFast = analyzer.getFastCorrelation();
+    const float newSlow = analyzer.getSlowCorrelation();
+
+    // Returns the columns between the ends of two bars, grown by a pixel for the borders
+    auto columnsBetween = [](int x1, int x2, juce::Rectangle<int> rows)
+    {
+        return rows.withX(juce::jmin(x1, x2) - 1).withWidth(std::abs(x1 - x2) + 2);
+    };
+
+    // The fast bar only covers the top third, the slow bar the whole height
+    if (mapToX(newFast) != mapToX(fastCorrelation))
+    {
+        repaint(columnsBetween(mapToX(fastCorrelation), mapToX(newFast), getLocalBounds().removeFromTop(getHeight() / 3)));
+        fastCorrelation = newFast;
+    }
 
-    // Set the duration for averaging for both slow and peak averagers
-    peakAverager.setAveragerDuration(average_time);
-    slowAverager.setAveragerDuration(average_time);
+    if (mapToX(newSlow) != mapToX(slowCorrelation))
+    {
+        repaint(columnsBetween(mapToX(slowCorrelation), mapToX(newSlow), getLocalBounds()));
+        slowCorrelation = newSlow;
+    }
 
-    for (int i = 0; i < numSamples; i++)
+    // The readout shows tenths, so it is only repainted when the shown digit changes
+    const int newTenths = juce::roundToInt(newSlow * 10.f);
+    if (newTenths != slowCorrelationTenths)
     {
-        auto left = buffer.getSample(0, i);
-        auto right = buffer.getSample(1, i);
-
-        // Calculate correlation using the filters
-        auto numerator = filters[0].processSample(left * right);
-        auto denominator = sqrt(filters[1].processSample(left * left) * filters[2].processSample(right * right));
-
-        if (std::isnan(numerator) || std::isinf(numerator) ||
-            std::isnan(denominator) || std::isinf(denominator) || denominator == 0.0f)
-        {
-            // Handle special cases where correlation calculation fails
-            peakAverager.add(0.f);
-            slowAverager.add(0.f);
-        }
-        else
-        {
-            // Calculate correlation and add it to both averagers
-            auto correlation = numerator / denominator;
-            peakAverager.add(correlation);
-            slowAverager.add(correlation);
-        }
+        slowCorrelationTenths = newTenths;
+        repaint(getReadoutArea());
     }
+}
 
-    // Repaint the component after updating the correlation
-    repaint();
+int CorrelationMeter::mapToX(float correlation) const
+{
+    // Same mapping as drawAverage, which spans the whole width for both bars
+    return static_cast<int>(juce::jmap(correlation, -1.0f, 1.0f, 0.f, static_cast<float>(getWidth())));
+}
+
+juce::Rectangle<int> CorrelationMeter::getReadoutArea() const
+{
+    // Right end of the part of the meter only covered by the slow bar
+    return getLocalBounds().withTrimmedTop(getHeight() / 3).reduced(4, 0).removeFromRight(30);
 }
 
 void CorrelationMeter::drawAverage(juce::Graphics& g, juce::Rectangle<int> bounds, float avg, bool drawBorder)
@@ -1,32 +1,84 @@
-
 #pragma once
-#include "../GonioMeter/Goniometer.h"
+#include <JuceHeader.h>
+#include "../Constants.h"
+#include "../DSP/BiquadBank.h"
+#include "../Rendering/NumericGlyphCache.h"
+#include "../Profiling/PaintProfiler.h"
 using namespace juce;
 
+//==============================================================================
+// Stereo correlation measurement that runs on the audio thread over every sample.
+// The products L*R, L*L and R*R are smoothed by one-pole integrators at a fast and a
+// slow time constant, and the correlation of each pair is published after every block.
+struct CorrelationAnalyzer
+{
+    static constexpr float fastTimeConstantMs = 50.f; // Time constant of the fast reading
+
+    // Derives the integrator coefficients for the given sample rate and clears their state
+    void prepare(double sampleRate);
+
+    // Measures the given buffer, called from processBlock
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Sets the time constant of the slow reading in milliseconds, called from the GUI
+    void setSlowTimeConstant(float milliseconds) { slowTimeConstantMs.store(milliseconds); }
+
+    // Returns the correlation with the fast time constant, from -1 to +1
+    float getFastCorrelation() const { return fastCorrelation.load(); }
+
+    // Returns the correlation with the slow time constant, from -1 to +1
+    float getSlowCorrelation() const { return slowCorrelation.load(); }
+
+private:
+    // Returns the correlation of the integrators starting at the given lane
+    float getCorrelation(int lane) const;
+
+    // Lanes 0 - 2 hold L*R, L*L and R*R with the fast time constant, lanes 3 - 5 the same
+    // with the slow time constant. The last two lanes pad the set to a full SIMD width.
+    using IntegratorBank = BiquadBank<8>;
+
+    IntegratorBank integrators; // One-pole integrators of the products
+    IntegratorBank::Frame outputs {}; // Integrator outputs after the latest sample
+    double currentSampleRate = 44100.0; // Sample rate the coefficients were derived for
+    float currentSlowTimeConstantMs = 0.f; // Slow time constant the coefficients were derived for
+
+    std::atomic<float> slowTimeConstantMs { 100.f }; // Slow time constant requested by the GUI
+    std::atomic<float> fastCorrelation { 0.f }; // Published fast correlation
+    std::atomic<float> slowCorrelation { 0.f }; // Published slow correlation
+};
+
 //==============================================================================
 struct CorrelationMeter : juce::Component
 {
-    // Constructor to initialize CorrelationMeter with an audio buffer and sample rate
-    CorrelationMeter(juce::AudioBuffer<float>& buf, double sampleRate);
+    // Constructor to initialize CorrelationMeter with the analyzer to display
+    CorrelationMeter(CorrelationAnalyzer& analyzerInput);
 
     // Override of the paint function to handle the drawing of the correlation meter
     void paint(juce::Graphics& g) override;
 
-    // Function to update the correlation meter based on the average time
-    void update(juce::int64 average_time);
+    // Function to update the correlation meter with the latest readings of the analyzer.
+    // Only the columns between the old and new end of a bar are repainted, and a bar that
+    // moved by less than a pixel keeps its old reading.
+    void update();
 
 private:
-    // Reference to the audio buffer
-    juce::AudioBuffer<float>& buffer;
+    // Function to map a correlation reading to the x-coordinate of the end of its bar
+    int mapToX(float correlation) const;
+
+    // Function to get the area of the slow correlation readout
+    juce::Rectangle<int> getReadoutArea() const;
 
-    // Type alias for the filter used in correlation meter
-    using FilterType = juce::dsp::IIR::Filter<float>;
+    // Reference to the analyzer providing the correlation readings
+    CorrelationAnalyzer& analyzer;
 
-    // Array to hold the filters used in the correlation meter
-    std::array<FilterType, 3> filters;
+    // Fast and slow correlation readings currently shown
+    float fastCorrelation = 0.f, slowCorrelation = 0.f;
 
-    // Averager objects for slow and peak averaging
-    Averager<float> slowAverager{1024 * 3, 0}, peakAverager{512, 0};
+    // Slow correlation shown by the readout in tenths, and the pre-rendered strings it is drawn from
+    int slowCorrelationTenths = 0;
+    juce::SharedResourcePointer<NumericGlyphCache> glyphCache;
+    const juce::Font readoutFont { 12.f };
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 
     // Function to draw the average on the correlation meter
     void drawAverage(juce::Graphics& g,
@@ -0,0 +1,349 @@
+#include "Benchmarks.h"
+#include "BiquadBank.h"
+#include "../GonioMeter/PointMapping.h"
+#include "../Rendering/PolylineRenderer.h"
+#include "../SpectrumAnalyzer/SpectrumAnalyzer.h"
+#include "../Constants.h"
+
+//==============================================================================
+// Implementation for the Benchmarks class
+void Benchmarks::runAll()
+{
+    runBiquadBank();
+    runPointMapping();
+    runPolylineRenderer();
+    runRealTimeAnalyzer();
+}
+
+double Benchmarks::measure(const std::function<void()>& function, int numRuns)
+{
+    // Warm up the caches before timing
+    function();
+
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < numRuns; ++run)
+    {
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        function();
+        best = juce::jmin(best, juce::Time::getMillisecondCounterHiRes() - start);
+    }
+
+    return best;
+}
+
+void Benchmarks::report(const juce::String& name, double optimisedMs, double referenceMs)
+{
+    juce::Logger::writeToLog(name + ": " + juce::String(optimisedMs, 3) + " ms, reference "
+        + juce::String(referenceMs, 3) + " ms, speedup " + juce::String(referenceMs / juce::jmax(optimisedMs, 1.0e-6), 2) + "x");
+}
+
+void Benchmarks::runBiquadBank()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 48000; // One second of audio
+    constexpr int numLanes = 8;
+    constexpr int numStages = 4;
+
+    juce::Random random(1);
+    std::vector<float> input(numSamples);
+    for (auto& sample : input)
+        sample = random.nextFloat() * 2.f - 1.f;
+
+    // The same low pass section in every slot, so both versions do identical work
+    const auto coefficients = BiquadCoefficients::makeLowPass(sampleRate, 1000.0);
+    volatile float sink = 0.f;
+
+    BiquadBank<numLanes, numStages> bank;
+    for (int stage = 0; stage < numStages; ++stage)
+        bank.setCoefficients(stage, coefficients);
+
+    const auto bankMs = measure([&]
+    {
+        bank.reset();
+        float sum = 0.f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            decltype(bank)::Frame frame;
+            frame.fill(input[i]);
+            bank.process(frame);
+            sum += frame[numLanes - 1];
+        }
+        sink = sum;
+    });
+
+    std::array<juce::dsp::IIR::Filter<float>, numLanes * numStages> filters;
+    juce::dsp::IIR::Coefficients<float>::Ptr scalarCoefficients = new juce::dsp::IIR::Coefficients<float>(
+        static_cast<float>(coefficients.b0), static_cast<float>(coefficients.b1), static_cast<float>(coefficients.b2),
+        1.f, static_cast<float>(coefficients.a1), static_cast<float>(coefficients.a2));
+    for (auto& filter : filters)
+        filter.coefficients = scalarCoefficients;
+
+    const auto scalarMs = measure([&]
+    {
+        for (auto& filter : filters)
+            filter.reset();
+
+        float sum = 0.f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float y = 0.f;
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                y = input[i];
+                for (int stage = 0; stage < numStages; ++stage)
+                    y = filters[lane * numStages + stage].processSample(y);
+            }
+            sum += y;
+        }
+        sink = sum;
+    });
+
+    juce::ignoreUnused(sink);
+    report("BiquadBank 8 lanes x 4 sections, 1 s at 48 kHz", bankMs, scalarMs);
+}
+
+void Benchmarks::runPointMapping()
+{
+    constexpr int numPoints = 2048; // One goniometer frame at the point budget
+    constexpr int numFrames = 1000;
+    const juce::Rectangle<int> bounds(0, 0, 285, 285); // Default goniometer size
+
+    juce::Random random(1);
+    std::vector<float> left(numPoints), right(numPoints), xs(numPoints), ys(numPoints);
+    for (int i = 0; i < numPoints; ++i)
+    {
+        left[i] = random.nextFloat() * 2.f - 1.f;
+        right[i] = random.nextFloat() * 2.f - 1.f;
+    }
+
+    const float maxGain = juce::Decibels::decibelsToGain(MAX_DECIBELS);
+    volatile float sink = 0.f;
+
+    PointMapping mapping;
+    mapping.centreX = static_cast<float>(bounds.getCentreX());
+    mapping.centreY = static_cast<float>(bounds.getCentreY());
+    mapping.pixelsPerUnit = static_cast<float>(bounds.getWidth() - 40) / maxGain;
+
+    const auto kernelMs = measure([&]
+    {
+        float peak = 0.f;
+        for (int frame = 0; frame < numFrames; ++frame)
+            peak += mapping.process(left.data(), right.data(), numPoints, xs.data(), ys.data());
+        sink = peak + xs[numPoints - 1];
+    });
+
+    const auto scalarMs = measure([&]
+    {
+        // The coefficient and the gain range are computed once per frame, as the old paint did
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const float coefficient = juce::Decibels::decibelsToGain(0.f + juce::Decibels::gainToDecibels(1.f));
+            const float minGain = juce::Decibels::decibelsToGain(NEGATIVE_INFINITY);
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                const float S = (left[i] - right[i]) * coefficient;
+                const float M = (left[i] + right[i]) * coefficient;
+
+                const auto a = static_cast<float>(bounds.getX()) + bounds.getWidth() / 2;
+                const auto b = static_cast<float>(bounds.getRight()) + bounds.getWidth() / 2 - 40;
+                const auto c = static_cast<float>(bounds.getBottom()) - bounds.getHeight() / 2 - 40;
+                const auto d = static_cast<float>(bounds.getY()) - bounds.getHeight() / 2;
+                xs[i] = juce::jmap(S, minGain, maxGain, a, b);
+                ys[i] = juce::jmap(M, minGain, maxGain, c, d);
+            }
+        }
+        sink = xs[numPoints - 1];
+    });
+
+    juce::ignoreUnused(sink);
+    report("PointMapping, 1000 frames of 2048 points", kernelMs, scalarMs);
+
+    // Throughput in points per microsecond for both versions
+    const double totalPoints = static_cast<double>(numPoints) * numFrames;
+    juce::Logger::writeToLog("PointMapping: " + juce::String(totalPoints / (kernelMs * 1000.0), 1) + " points/us, reference "
+        + juce::String(totalPoints / (scalarMs * 1000.0), 1) + " points/us");
+}
+
+void Benchmarks::runPolylineRenderer()
+{
+    constexpr int numBins = 1024; // Half of the 2048 point FFT
+    constexpr int height = 200;
+    constexpr int numFrames = 100;
+    const juce::Colour colour(0xff48bde8);
+
+    // A spectrum falling towards the high frequencies with some noise, as dB values
+    juce::Random random(1);
+    std::vector<float> levels(numBins);
+    for (int bin = 0; bin < numBins; ++bin)
+        levels[static_cast<size_t>(bin)] = -20.f - 60.f * static_cast<float>(bin) / numBins + random.nextFloat() * 12.f;
+
+    volatile int sink = 0;
+
+    // Stroke the curve at the width of a small, the default and a large spectrum view
+    for (const int width : { 300, 600, 1200 })
+    {
+        // Points mapped like the AnalyzerPathGenerator, x on a log scale and one per bin
+        std::vector<juce::Point<float>> points(numBins);
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const float frequency = (bin + 1) * 48000.f / (2.f * numBins);
+            points[static_cast<size_t>(bin)] = { std::floor(juce::mapFromLog10(juce::jlimit(20.f, 20000.f, frequency), 20.f, 20000.f) * width),
+                                                 juce::jmap(levels[static_cast<size_t>(bin)], NEGATIVE_INFINITY, 0.f, static_cast<float>(height), 0.f) };
+        }
+
+        juce::Image image(juce::Image::ARGB, width, height, true);
+        PolylineRenderer renderer;
+        Polyline polyline;
+
+        const auto rendererMs = measure([&]
+        {
+            for (int frame = 0; frame < numFrames; ++frame)
+            {
+                polyline.startNewSubPath(points.front());
+                for (size_t i = 1; i < points.size(); ++i)
+                    polyline.lineTo(points[i]);
+
+                image.clear(image.getBounds());
+                juce::Image::BitmapData data(image, juce::Image::BitmapData::readWrite);
+                renderer.strokePolyline(data, polyline, colour);
+            }
+            sink = image.getPixelAt(width / 2, height / 2).getAlpha();
+        });
+
+        const auto pathMs = measure([&]
+        {
+            for (int frame = 0; frame < numFrames; ++frame)
+            {
+                juce::Path path;
+                path.preallocateSpace(3 * width);
+                path.startNewSubPath(points.front());
+                for (size_t i = 1; i < points.size(); ++i)
+                    path.lineTo(points[i]);
+
+                image.clear(image.getBounds());
+                juce::Graphics g(image);
+                g.setColour(colour);
+                g.strokePath(path, juce::PathStrokeType(1.f));
+            }
+            sink = image.getPixelAt(width / 2, height / 2).getAlpha();
+        });
+
+        report("PolylineRenderer stroke, 100 curves of 1024 points at " + juce::String(width) + " x " + juce::String(height), rendererMs, pathMs);
+    }
+
+    // Fill a full level history image under its curve with the histogram gradient
+    constexpr int width = 600;
+    std::vector<float> tops(width);
+    for (int x = 0; x < width; ++x)
+        tops[static_cast<size_t>(x)] = juce::jmap(levels[static_cast<size_t>(x % numBins)], NEGATIVE_INFINITY, MAX_DECIBELS, static_cast<float>(height), 0.f);
+
+    const juce::ColourGradient gradient(HIGHLIGHT_COLOR.withAlpha(0.8f), 0.f, 0.f, BASE_COLOR.withAlpha(0.3f), 0.f, static_cast<float>(height), false);
+    std::vector<juce::PixelARGB> rows(height);
+    for (int row = 0; row < height; ++row)
+        rows[static_cast<size_t>(row)] = gradient.getColourAtPosition((row + 0.5) / height).getPixelARGB();
+
+    juce::Image image(juce::Image::ARGB, width, height, true);
+
+    const auto fillMs = measure([&]
+    {
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            image.clear(image.getBounds());
+            juce::Image::BitmapData data(image, juce::Image::BitmapData::readWrite);
+            for (int x = 0; x < width; ++x)
+                PolylineRenderer::fillColumn(data, x, tops[static_cast<size_t>(x)], rows.data());
+        }
+        sink = image.getPixelAt(width / 2, height - 1).getAlpha();
+    });
+
+    const auto fillPathMs = measure([&]
+    {
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            juce::Path area;
+            area.preallocateSpace(3 * width + 6);
+            area.startNewSubPath(0.f, static_cast<float>(height));
+            for (int x = 0; x < width; ++x)
+            {
+                area.lineTo(static_cast<float>(x), tops[static_cast<size_t>(x)]);
+                area.lineTo(static_cast<float>(x + 1), tops[static_cast<size_t>(x)]);
+            }
+            area.lineTo(static_cast<float>(width), static_cast<float>(height));
+            area.closeSubPath();
+
+            image.clear(image.getBounds());
+            juce::Graphics g(image);
+            g.setGradientFill(gradient);
+            g.fillPath(area);
+        }
+        sink = image.getPixelAt(width / 2, height - 1).getAlpha();
+    });
+
+    juce::ignoreUnused(sink);
+    report("PolylineRenderer fill, 100 histories of 600 x 200", fillMs, fillPathMs);
+}
+
+void Benchmarks::runRealTimeAnalyzer()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 48000; // One second of audio
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 512;
+    constexpr float analysisRate = 15.f; // Lowest analysis rate of the spectrum view
+
+    juce::Random random(1);
+    juce::AudioBuffer<float> input(numChannels, numSamples);
+    for (int channel = 0; channel < numChannels; ++channel)
+        for (int i = 0; i < numSamples; ++i)
+            input.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+
+    volatile float sink = 0.f;
+
+    // The RTA filters every sample on the audio thread, in blocks of a typical host size
+    RealTimeAnalyzer rta;
+    rta.prepare(sampleRate);
+    rta.setFrameRate(analysisRate);
+    rta.interest.add();
+
+    const auto rtaMs = measure([&]
+    {
+        for (int start = 0; start + blockSize <= numSamples; start += blockSize)
+        {
+            const juce::AudioBuffer<float> block(input.getArrayOfWritePointers(), numChannels, start, blockSize);
+            rta.process(block);
+        }
+
+        RtaFrame frame;
+        while (rta.getFrame(frame))
+            sink = frame.levels[0];
+    });
+
+    rta.interest.remove();
+
+    // The FFT path transforms the latest 2048 samples of each channel once per analysis frame
+    FFTDataGenerator<std::vector<float>> generator;
+    generator.changeOrder(FFTOrder::order2048);
+    const int fftSize = generator.getFFTSize();
+    const int numFrames = juce::roundToInt(analysisRate * numSamples / sampleRate);
+    std::vector<float> fftData;
+
+    const auto fftMs = measure([&]
+    {
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const int start = juce::jmin(numSamples - fftSize, frame * numSamples / numFrames);
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const juce::AudioBuffer<float> latest(input.getArrayOfWritePointers() + channel, 1, start, fftSize);
+                generator.produceFFTDataForRendering(latest, NEGATIVE_INFINITY);
+                while (generator.getNumAvailableFFTDataBlocks() > 0)
+                    generator.getFFTData(fftData);
+            }
+        }
+        sink = fftData[0];
+    });
+
+    juce::ignoreUnused(sink);
+    report("RealTimeAnalyzer vs FFTDataGenerator at 15 Hz, 1 s of stereo at 48 kHz", rtaMs, fftMs);
+}
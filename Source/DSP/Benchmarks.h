@@ -0,0 +1,35 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Micro-benchmarks of the DSP and drawing kernels. They run once when the processor is created
+// if RUN_BENCHMARKS is enabled, and write their results to the JUCE logger.
+struct Benchmarks
+{
+    // Runs every benchmark
+    static void runAll();
+
+    // Compares an 8 lane, 4 section BiquadBank against the same 32 sections
+    // run as scalar juce::dsp::IIR::Filter objects
+    static void runBiquadBank();
+
+    // Compares the goniometer PointMapping kernel against the original per-sample mapping,
+    // which rebuilt the mapping from the component bounds and used jmap for every sample
+    static void runPointMapping();
+
+    // Compares the PolylineRenderer against juce::Graphics for a spectrum curve stroked at
+    // typical display widths and for a level history filled under its curve
+    static void runPolylineRenderer();
+
+    // Compares the RealTimeAnalyzer on one second of stereo audio against the FFTDataGenerator
+    // analysing both channels at the lowest analysis rate of the spectrum view
+    static void runRealTimeAnalyzer();
+
+private:
+    // Returns the fastest of several runs of the given function in milliseconds
+    static double measure(const std::function<void()>& function, int numRuns = 10);
+
+    // Writes a comparison of two timings to the log
+    static void report(const juce::String& name, double optimisedMs, double referenceMs);
+};
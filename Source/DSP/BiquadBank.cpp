@@ -0,0 +1,93 @@
+#include "BiquadBank.h"
+#include <complex>
+
+//==============================================================================
+// Implementation for the BiquadCoefficients class
+BiquadCoefficients BiquadCoefficients::makeLowPass(double sampleRate, double frequency, double q)
+{
+    // Bilinear transform of the analogue prototype (Audio EQ Cookbook)
+    const auto w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, sampleRate * 0.49) / sampleRate;
+    const auto cosW0 = std::cos(w0);
+    const auto alpha = std::sin(w0) / (2.0 * q);
+    const auto a0 = 1.0 + alpha;
+
+    BiquadCoefficients c;
+    c.b0 = (1.0 - cosW0) / 2.0 / a0;
+    c.b1 = (1.0 - cosW0) / a0;
+    c.b2 = c.b0;
+    c.a1 = -2.0 * cosW0 / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+BiquadCoefficients BiquadCoefficients::makeHighPass(double sampleRate, double frequency, double q)
+{
+    // Bilinear transform of the analogue prototype (Audio EQ Cookbook)
+    const auto w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, sampleRate * 0.49) / sampleRate;
+    const auto cosW0 = std::cos(w0);
+    const auto alpha = std::sin(w0) / (2.0 * q);
+    const auto a0 = 1.0 + alpha;
+
+    BiquadCoefficients c;
+    c.b0 = (1.0 + cosW0) / 2.0 / a0;
+    c.b1 = -(1.0 + cosW0) / a0;
+    c.b2 = c.b0;
+    c.a1 = -2.0 * cosW0 / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+BiquadCoefficients BiquadCoefficients::makeOnePole(double timeConstantMs, double sampleRate)
+{
+    // y[n] = y[n-1] + k * (x[n] - y[n-1]), which reaches 1 - 1/e of a step after the time constant
+    const auto k = 1.0 - std::exp(-1000.0 / (juce::jmax(1.0, timeConstantMs) * sampleRate));
+
+    BiquadCoefficients c;
+    c.b0 = k;
+    c.b1 = 0.0;
+    c.b2 = 0.0;
+    c.a1 = k - 1.0;
+    c.a2 = 0.0;
+    return c;
+}
+
+std::vector<BiquadCoefficients> BiquadCoefficients::makeButterworthBandPass(double sampleRate, double lowEdge, double highEdge, int order)
+{
+    // Prewarp the edges so they land on the right frequencies after the bilinear transform
+    const auto c = 2.0 * sampleRate;
+    const auto w1 = c * std::tan(juce::MathConstants<double>::pi * lowEdge / sampleRate);
+    const auto w2 = c * std::tan(juce::MathConstants<double>::pi * highEdge / sampleRate);
+    const auto centreSquared = w1 * w2;
+    const auto bandwidth = w2 - w1;
+
+    std::vector<BiquadCoefficients> sections;
+    sections.reserve(static_cast<size_t>(order));
+
+    // Each low pass prototype pole p maps to the two band pass poles solving s^2 - p B s + w0^2 = 0.
+    // The poles in the upper half plane and their conjugates form one section B s / (s^2 + a s + b).
+    for (int k = 1; k <= order; ++k)
+    {
+        const auto pole = std::polar(1.0, juce::MathConstants<double>::pi * (2.0 * k + order - 1.0) / (2.0 * order)) * bandwidth;
+        const auto root = std::sqrt(pole * pole - 4.0 * centreSquared);
+
+        for (const auto& q : { (pole + root) / 2.0, (pole - root) / 2.0 })
+        {
+            if (q.imag() <= 0.0)
+                continue;
+
+            const auto a = -2.0 * q.real();
+            const auto b = std::norm(q);
+            const auto d0 = c * c + a * c + b;
+
+            BiquadCoefficients section;
+            section.b0 = bandwidth * c / d0;
+            section.b1 = 0.0;
+            section.b2 = -section.b0;
+            section.a1 = (2.0 * b - 2.0 * c * c) / d0;
+            section.a2 = (c * c - a * c + b) / d0;
+            sections.push_back(section);
+        }
+    }
+
+    return sections;
+}
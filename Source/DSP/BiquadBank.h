@@ -0,0 +1,102 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Normalised biquad coefficients (a0 == 1) with factories for the filter shapes used by the meters.
+// They are kept in double precision so narrow low-frequency bands can use a double bank.
+struct BiquadCoefficients
+{
+    // Returns a second order low pass, Butterworth by default
+    static BiquadCoefficients makeLowPass(double sampleRate, double frequency, double q = juce::MathConstants<double>::sqrt2 / 2.0);
+
+    // Returns a second order high pass, Butterworth by default
+    static BiquadCoefficients makeHighPass(double sampleRate, double frequency, double q = juce::MathConstants<double>::sqrt2 / 2.0);
+
+    // Returns a one-pole integrator (leaky average) with the given time constant in milliseconds
+    static BiquadCoefficients makeOnePole(double timeConstantMs, double sampleRate);
+
+    // Returns the order second order sections of a Butterworth band pass between the two edge frequencies
+    // (IEC 61260 / ANSI S1.11 class filters use order 3). The edges must lie below Nyquist.
+    static std::vector<BiquadCoefficients> makeButterworthBandPass(double sampleRate, double lowEdge, double highEdge, int order);
+
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0; // Pass-through by default
+};
+
+//==============================================================================
+// Bank of NumLanes independent biquad cascades of NumStages sections each, stored as a
+// structure of arrays. Every stage updates all of its lanes in one branch-free loop, so the
+// compiler maps the lanes onto SIMD registers and a bank of 4 or 8 filters costs about as
+// much as a single scalar filter. Lanes can hold channels, bands or both.
+template<int NumLanes, int NumStages = 1, typename SampleType = float>
+struct BiquadBank
+{
+    static constexpr int numLanes = NumLanes; // Number of independent filters
+    static constexpr int numStages = NumStages; // Number of sections in each filter
+
+    using Frame = std::array<SampleType, NumLanes>; // One sample for every lane
+
+    // Sets the coefficients of one section of one lane
+    void setCoefficients(int stage, int lane, const BiquadCoefficients& c)
+    {
+        auto& s = stages[stage];
+        s.b0[lane] = static_cast<SampleType>(c.b0);
+        s.b1[lane] = static_cast<SampleType>(c.b1);
+        s.b2[lane] = static_cast<SampleType>(c.b2);
+        s.a1[lane] = static_cast<SampleType>(c.a1);
+        s.a2[lane] = static_cast<SampleType>(c.a2);
+    }
+
+    // Sets the coefficients of one section of every lane
+    void setCoefficients(int stage, const BiquadCoefficients& c)
+    {
+        for (int lane = 0; lane < NumLanes; ++lane)
+            setCoefficients(stage, lane, c);
+    }
+
+    // Clears the filter states of every lane
+    void reset()
+    {
+        for (auto& s : stages)
+        {
+            s.z1.fill(0);
+            s.z2.fill(0);
+        }
+    }
+
+    // Filters one sample of every lane in place through all sections (transposed direct form II)
+    void process(Frame& x)
+    {
+        for (auto& s : stages)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                const SampleType y = s.b0[lane] * x[lane] + s.z1[lane];
+                s.z1[lane] = s.b1[lane] * x[lane] - s.a1[lane] * y + s.z2[lane];
+                s.z2[lane] = s.b2[lane] * x[lane] - s.a2[lane] * y;
+                x[lane] = y;
+            }
+        }
+    }
+
+private:
+    // Coefficients and states of one section across all lanes
+    struct Stage
+    {
+        alignas(32) Frame b0, b1, b2, a1, a2; // Coefficients
+        alignas(32) Frame z1, z2; // States
+
+        Stage()
+        {
+            b0.fill(1);
+            b1.fill(0);
+            b2.fill(0);
+            a1.fill(0);
+            a2.fill(0);
+            z1.fill(0);
+            z2.fill(0);
+        }
+    };
+
+    std::array<Stage, NumStages> stages; // Sections, processed in order
+};
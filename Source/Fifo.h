@@ -0,0 +1,138 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+// A standard AbstractFifo-based templated FIFO class
+template<typename T, size_t Size>
+struct Fifo
+{
+    // Returns the fixed size of the FIFO buffer.
+    size_t getSize() const noexcept { return Size; }
+
+    // Prepares the FIFO buffer for writing with the given number of samples and channels
+    void prepare(int numSamples, int numChannels)
+    {
+        for (auto& buffer : buffers)
+        {
+            buffer.setSize(numChannels,
+                numSamples,
+                false, // clearUnusedChannels
+                true,  // allocateExtraSpace
+                true); // avoidReallocating
+            buffer.clear();
+        }
+    }
+
+    // Pushes an element into the FIFO buffer
+    bool push(const T& t)
+    {
+        auto write = fifo.read(1);
+        if (write.blockSize1 > 0)
+        {
+            buffers[write.startIndex1] = t;
+            return true;
+        }
+        return false;
+    }
+
+    // Pulls an element from the FIFO buffer
+    bool pull(T& t)
+    {
+        auto read = fifo.write(1);
+        if (read.blockSize1 > 0)
+        {
+            t = buffers[read.startIndex1];
+            return true;
+        }
+        return false;
+    }
+
+    // Returns the number of elements available for reading from the FIFO buffer
+    int getNumAvailableForReading() const
+    {
+        // TODO:
+        // If you are using MacOS and the meters are not responding to the audio signals,
+        // try removing the return keyword
+        return fifo.getNumReady();
+    }
+
+    // Returns the available space in the FIFO buffer for writing
+    int getAvailableSpace() const
+    {
+        // TODO:
+        // If you are using MacOS and the meters are not responding to the audio signals
+        // try removing the return keyword
+        return fifo.getFreeSpace();
+    }
+
+private:
+    juce::AbstractFifo fifo{Size}; // AbstractFifo object to manage buffer read/write positions
+    std::array<T, Size> buffers; // Array of buffers to store data elements
+};
+
+//==============================================================================
+template<typename T>
+struct FifoSpectrumAnalyzer
+{
+    // Prepares the analyzer with the given number of channels and samples per channel
+    void prepare(int numChannels, int numSamples)
+    {
+        for (auto& buffer : buffers)
+        {
+            buffer.setSize(numChannels, numSamples, false, true, true);
+            buffer.clear();
+        }
+    }
+
+    // Prepares the analyzer with the specified number of elements for each channel
+    void prepare(size_t numElements)
+    {
+        for (auto& buffer : buffers)
+        {
+            buffer.clear();
+            buffer.resize(numElements, 0);
+        }
+    }
+
+    // Pushes an element into the analyzer's FIFO buffer
+    bool push(const T& t)
+    {
+        auto write = fifo.write(1);
+        if (write.blockSize1 > 0)
+        {
+            buffers[write.startIndex1] = t;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Pulls an element from the analyzer's FIFO buffer
+    bool pull(T& t)
+    {
+        auto read = fifo.read(1);
+        if (read.blockSize1 > 0)
+        {
+            t = buffers[read.startIndex1];
+            return true;
+        }
+
+        return false;
+    }
+
+    // Returns the number of elements available for reading from the FIFO buffer
+    int getNumAvailableForReading() const
+    {
+        return fifo.getNumReady();
+    }
+
+    // Returns the number of elements the FIFO buffer holds
+    static constexpr int getCapacity() { return Capacity; }
+
+private:
+    static constexpr int Capacity = 30; // Capacity of the FIFO buffer
+    std::array<T, Capacity> buffers;    // Array of buffers to store data elements
+    juce::AbstractFifo fifo {Capacity};  // AbstractFifo object to manage buffer read/write positions
+};
@@ -2,88 +2,301 @@
 
 //==============================================================================
 // Implementation for the Goniometer class
-Goniometer::Goniometer(juce::AudioBuffer<float>& bufferInput) : buffer(bufferInput)
+Goniometer::Goniometer(GoniometerStream& streamInput, StereoHeatmap& heatmapInput, PolarAnalyzer& polarInput) :
+    stream(streamInput),
+    heatmap(heatmapInput),
+    polar(polarInput)
 {
-    // Initialize the internal buffer with the same size as the input buffer and clear it
-    internalBuffer.setSize(2, bufferInput.getNumSamples(), false, true, true);
-    internalBuffer.clear();
     // Initialize the scaling factor
     scale = 1;
+    buildColourMap();
+    heatmapGrid.assign(static_cast<size_t>(StereoHeatmap::gridSize * StereoHeatmap::gridSize), 0.f);
+    visibilityChanged();
 }
 
 void Goniometer::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Goniometer);
+
+    if (mode == PolarSample || mode == PolarLevel)
+    {
+        drawPolarBackground(g);
+
+        // Both polar modes are rendered in update, painting only blits them
+        if (phosphorImage.isValid())
+            g.drawImageAt(phosphorImage, 0, 0);
+
+        return;
+    }
+
     // Draw the background of the goniometer
     drawBackground(g);
-    // Clear the path for drawing the visualization
-    p.clear();
 
-    // Copy the audio data from the input buffer to the internal buffer
-    for (int channel = 0; channel < 2; ++channel) // Assuming stereo data (2 channels)
+    if (mode == Heatmap)
     {
-        internalBuffer.copyFrom(channel, 0, buffer, channel, 0, internalBuffer.getNumSamples());
+        // The grid spans the circle at 100% scale and is stretched with the scale knob,
+        // clipped to the background ellipse
+        juce::Graphics::ScopedSaveState state(g);
+        juce::Path ellipse;
+        ellipse.addEllipse(center.getX() - w / 2.f, center.getY() - h / 2.f, static_cast<float>(w), static_cast<float>(h));
+        g.reduceClipRegion(ellipse);
+        g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+        g.drawImage(heatmapImage, juce::Rectangle<float>(w * scale, h * scale).withCentre(center.toFloat()));
+        return;
     }
 
-    // Get the size of the internal buffer
-    int internalBufferSize = internalBuffer.getNumSamples();
+    // The phosphor is rendered in update, painting only blits it
+    if (phosphorImage.isValid())
+        g.drawImageAt(phosphorImage, 0, 0);
+}
+
+void Goniometer::update()
+{
+    // Nothing to render while another view is shown
+    if (accumulation.empty() || !isVisible())
+        return;
 
-    // Apply different processing depending on the buffer size
-    if (internalBufferSize < 256)
+    if (mode == Heatmap)
     {
-        // Apply gain reduction if the buffer size is less than 256 samples
-        internalBuffer.applyGain(juce::Decibels::decibelsToGain(-3.f));
+        // Only the latest grid is shown
+        bool received = false;
+        while (heatmap.getGrid(heatmapGrid))
+            received = true;
+
+        // A settled heatmap is not repainted, so the editor can idle
+        if (received && renderHeatmap())
+            repaint();
+        return;
     }
-    else
+
+    if (mode == PolarSample || mode == PolarLevel)
     {
-        // Calculate the scaling coefficient based on the scale factor
-        float coefficient = juce::Decibels::decibelsToGain(0.f + juce::Decibels::gainToDecibels(scale));
-        // Calculate the maximum and minimum gain values
-        float maxGain = juce::Decibels::decibelsToGain(MAX_DECIBELS);
-        float minGain = juce::Decibels::decibelsToGain(NEGATIVE_INFINITY);
+        // Only the latest frame is shown, the sector levels already include the older ones
+        const auto displayedLevels = polarFrame.levels;
+        const auto displayedHolds = polarFrame.holds;
+        while (polar.getFrame(polarFrame))
+        {
+        }
 
-        // Iterate over each sample in the internal buffer
-        for (int i = 0; i < internalBufferSize; ++i)
+        if (mode == PolarLevel)
         {
-            // Calculate the S and M values for each sample
-            float leftRaw = internalBuffer.getSample(0, i);
-            float rightRaw = internalBuffer.getSample(1, i);
-            float S = (leftRaw - rightRaw) * coefficient;
-            float M = (leftRaw + rightRaw) * coefficient;
-
-            // Map the S and M values to screen coordinates
-            auto a = (float)getLocalBounds().getX() + getWidth() / 2;
-            auto b = (float)getLocalBounds().getRight() + getWidth() / 2 - 40;
-            auto c = (float)getLocalBounds().getBottom() - getHeight() / 2 - 40;
-            auto d = (float)getLocalBounds().getY() - getHeight() / 2;
-            float xCoordinate = juce::jmap(S, minGain, maxGain, (float)a, (float)b);
-            float yCoordinate = juce::jmap(M, minGain, maxGain, (float)c, (float)d);
-
-            // Create a point representing the current sample in screen coordinates
-            juce::Point<float> point{xCoordinate, yCoordinate};
-
-            // Start a new sub-path if it's the first sample, otherwise add a line segment to the path
-            if (i == 0)
-            {
-                p.startNewSubPath(point);
-            }
-            if (point.isFinite())
+            if (polarFrame.levels != displayedLevels || polarFrame.holds != displayedHolds || polarLevelsStale)
             {
-                p.lineTo(point);
+                renderPolarLevels();
+                repaint();
             }
+            return;
+        }
+
+        plotPolarSamples();
+        if (renderPhosphor())
+            repaint();
+        return;
+    }
+
+    // Only the latest frame is plotted, older ones cover the same span of audio
+    while (stream.getFrame(points))
+    {
+    }
+
+    // Silent input settles into a still image, which is not repainted
+    plotSamples();
+    if (renderPhosphor())
+        repaint();
+}
+
+void Goniometer::plotSamples()
+{
+    const int numSamples = points.numPoints;
+    if (numSamples == 0)
+        return;
+
+    // L + R and L - R at MAX_DECIBELS reach the edge of the scale, scaled by the knob or the
+    // automatic gain. The mapping is computed once per frame rather than per sample.
+    PointMapping mapping;
+    mapping.centreX = static_cast<float>(center.x);
+    mapping.centreY = static_cast<float>(center.y);
+    mapping.pixelsPerUnit = (autoGain ? autoScale : scale) * static_cast<float>(w) / juce::Decibels::decibelsToGain(MAX_DECIBELS);
+
+    // Largest M/S magnitude of the frame, measured in the mapping pass for the automatic gain
+    const float framePeak = mapping.process(points.left.data(), points.right.data(), numSamples, pointsX.data(), pointsY.data());
+
+    splatPoints(numSamples);
+
+    // The new scaling factor applies from the next frame
+    updateAutoGain(framePeak);
+}
+
+void Goniometer::plotPolarSamples()
+{
+    // The positions are already polar, only the origin and radius of the half circle are applied
+    const int numPoints = polarFrame.numPoints;
+    const auto origin = polarToScreen(0.f, 0.f);
+    const float outerRadius = static_cast<float>(w) / 2.f;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        pointsX[static_cast<size_t>(i)] = origin.x + polarFrame.x[static_cast<size_t>(i)] * outerRadius;
+        pointsY[static_cast<size_t>(i)] = origin.y - polarFrame.y[static_cast<size_t>(i)] * outerRadius;
+    }
+
+    splatPoints(numPoints);
+}
+
+void Goniometer::splatPoints(int numSamples)
+{
+    if (numSamples == 0)
+        return;
+
+    const int width = phosphorImage.getWidth();
+    const int height = phosphorImage.getHeight();
+
+    // Spread a fixed amount of energy over the frame, so the brightness of a trace
+    // depends on how much time the signal spends there rather than on the sample rate
+    const float energy = juce::jmin(1.f, 1500.f / static_cast<float>(numSamples));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = pointsX[static_cast<size_t>(i)];
+        const float y = pointsY[static_cast<size_t>(i)];
+
+        // Skip points outside the image, including non-finite ones
+        if (!(x >= 0.f && y >= 0.f && x < static_cast<float>(width - 1) && y < static_cast<float>(height - 1)))
+            continue;
+
+        // Distribute the energy over the four neighbouring pixels
+        const int ix = static_cast<int>(x);
+        const int iy = static_cast<int>(y);
+        const float fx = x - static_cast<float>(ix);
+        const float fy = y - static_cast<float>(iy);
+        float* row = accumulation.data() + static_cast<size_t>(iy) * static_cast<size_t>(width) + ix;
+
+        row[0] += energy * (1.f - fx) * (1.f - fy);
+        row[1] += energy * fx * (1.f - fy);
+        row[width] += energy * (1.f - fx) * fy;
+        row[width + 1] += energy * fx * fy;
+    }
+}
+
+void Goniometer::updateAutoGain(float framePeak)
+{
+    const float attack = 1.f - std::exp(-1000.f / (autoGainAttackMs * frameRate));
+    const float release = 1.f - std::exp(-1000.f / (autoGainReleaseMs * frameRate));
+
+    envelope += (framePeak - envelope) * (framePeak > envelope ? attack : release);
+
+    // Hold the scale through silence instead of zooming into the noise floor
+    if (envelope > juce::Decibels::decibelsToGain(autoGainFloorDb))
+    {
+        // The envelope reaches the edge at MAX_DECIBELS / (2 * scale)
+        const float fullScale = juce::Decibels::decibelsToGain(MAX_DECIBELS);
+        autoScale = juce::jlimit(autoGainMinScale, autoGainMaxScale, autoGainTarget * fullScale / (2.f * envelope));
+    }
+}
+
+bool Goniometer::renderPhosphor()
+{
+    const int width = phosphorImage.getWidth();
+    const int height = phosphorImage.getHeight();
+    const float decay = std::exp(-1000.f / (persistenceMs * frameRate));
+    const float indexScale = static_cast<float>(colourMapSize - 1) / colourMapRange;
+
+    juce::Image::BitmapData pixels(phosphorImage, juce::Image::BitmapData::readWrite);
+    juce::uint32 differences = 0;
+
+    for (int y = 0; y < height; ++y)
+    {
+        float* energies = accumulation.data() + static_cast<size_t>(y) * static_cast<size_t>(width);
+        auto* line = reinterpret_cast<juce::PixelARGB*>(pixels.getLinePointer(y));
+
+        for (int x = 0; x < width; ++x)
+        {
+            const float e = energies[x];
+            const auto pixel = colourMap[static_cast<size_t>(juce::jmin(static_cast<float>(colourMapSize - 1), e * indexScale))];
+            differences |= line[x].getNativeARGB() ^ pixel.getNativeARGB();
+            line[x] = pixel;
+            energies[x] = e * decay;
+        }
+    }
+
+    return differences != 0;
+}
+
+bool Goniometer::renderHeatmap()
+{
+    // Logarithmic density relative to the busiest bin, so sparse regions stay visible.
+    // An empty grid maps every bin to the first, transparent entry.
+    const auto maximum = juce::FloatVectorOperations::findMaximum(heatmapGrid.data(), static_cast<int>(heatmapGrid.size()));
+    const float indexScale = maximum > 0.f ? static_cast<float>(colourMapSize - 1) / std::log1p(maximum) : 0.f;
+
+    juce::Image::BitmapData pixels(heatmapImage, juce::Image::BitmapData::readWrite);
+    juce::uint32 differences = 0;
+
+    for (int y = 0; y < StereoHeatmap::gridSize; ++y)
+    {
+        const float* bins = heatmapGrid.data() + static_cast<size_t>(y * StereoHeatmap::gridSize);
+        auto* line = reinterpret_cast<juce::PixelARGB*>(pixels.getLinePointer(y));
+
+        for (int x = 0; x < StereoHeatmap::gridSize; ++x)
+        {
+            const auto pixel = colourMap[static_cast<size_t>(juce::jlimit(0, colourMapSize - 1, static_cast<int>(std::log1p(bins[x]) * indexScale)))];
+            differences |= line[x].getNativeARGB() ^ pixel.getNativeARGB();
+            line[x] = pixel;
         }
     }
 
-    // Draw the path if it's not empty
-    if (!p.isEmpty())
+    return differences != 0;
+}
+
+void Goniometer::setMode(Mode newMode)
+{
+    if (mode == newMode)
+        return;
+
+    mode = newMode;
+    visibilityChanged();
+
+    // Start the phosphor from black instead of from the trace left when the mode was changed
+    std::fill(accumulation.begin(), accumulation.end(), 0.f);
+    polarLevelsStale = true;
+    repaint();
+}
+
+void Goniometer::visibilityChanged()
+{
+    // Only the analysis drawn by the current mode runs on the analysis thread
+    if (!isVisible())
+        interestRegistration.setTarget(nullptr);
+    else if (mode == Heatmap)
+        interestRegistration.setTarget(&heatmap.interest);
+    else if (mode == PolarSample || mode == PolarLevel)
+        interestRegistration.setTarget(&polar.interest);
+    else
+        interestRegistration.setTarget(&stream.interest);
+}
+
+void Goniometer::setAutoGain(bool shouldFollowLevel)
+{
+    // Start following from the manual scale, so engaging the automatic gain does not jump
+    if (shouldFollowLevel && !autoGain)
+        autoScale = scale;
+
+    autoGain = shouldFollowLevel;
+}
+
+void Goniometer::buildColourMap()
+{
+    // Faint traces glow in the outside colour and saturate towards the inside colour,
+    // with a soft knee like the phosphor of a hardware vectorscope
+    for (int i = 0; i < colourMapSize; ++i)
     {
-        // Flip the path vertically
-        p.applyTransform(juce::AffineTransform::verticalFlip(h));
-        // Create a gradient fill for the path
-        juce::ColourGradient gradientColor(pathColourInside, center.x, center.y,
-            pathColourOutside, w / 2, h / 2, true);
-        g.setGradientFill(gradientColor);
-        // Stroke the path with the gradient fill
-        g.strokePath(p, juce::PathStrokeType(1));
+        const float energy = static_cast<float>(i) / static_cast<float>(colourMapSize - 1) * colourMapRange;
+        const float brightness = 1.f - std::exp(-2.f * energy);
+        const float whiteness = juce::jlimit(0.f, 1.f, (energy - 1.f) / (colourMapRange - 1.f));
+
+        colourMap[static_cast<size_t>(i)] = pathColourOutside.interpolatedWith(pathColourInside, whiteness)
+                                                              .withAlpha(brightness)
+                                                              .getPixelARGB();
     }
 }
 
@@ -94,6 +307,20 @@ void Goniometer::resized()
     // Update the width and height variables used for drawing the background
     w = getWidth() - 40;
     h = getHeight() - 40;
+
+    // Start the phosphor from black at the new size
+    if (getWidth() > 0 && getHeight() > 0)
+    {
+        accumulation.assign(static_cast<size_t>(getWidth()) * static_cast<size_t>(getHeight()), 0.f);
+        phosphorImage = juce::Image(juce::Image::ARGB, getWidth(), getHeight(), true);
+    }
+    else
+    {
+        accumulation.clear();
+        phosphorImage = {};
+    }
+
+    polarLevelsStale = true;
 }
 
 void Goniometer::drawBackground(juce::Graphics& g)
@@ -144,11 +371,106 @@ void Goniometer::drawBackground(juce::Graphics& g)
     }
 }
 
-void Goniometer::update(juce::AudioBuffer<float>& bufferInput)
+juce::Point<float> Goniometer::polarToScreen(float angle, float radius) const
 {
-    // Clear the current buffer and update it with the new buffer
-    bufferInput.clear();
-    buffer = bufferInput;
+    // The half circle is centred vertically, with its origin at the middle of the bottom edge
+    const float outerRadius = static_cast<float>(w) / 2.f;
+    const juce::Point<float> origin(static_cast<float>(center.x), static_cast<float>(center.y) + outerRadius / 2.f);
+    return origin.getPointOnCircumference(radius * outerRadius, angle);
+}
+
+void Goniometer::drawPolarBackground(juce::Graphics& g)
+{
+    const auto origin = polarToScreen(0.f, 0.f);
+    const float outerRadius = static_cast<float>(w) / 2.f;
+    const float halfPi = juce::MathConstants<float>::halfPi;
+
+    // Fill the half circle with the base color and outline it with the edge color
+    juce::Path halfCircle;
+    halfCircle.addPieSegment(origin.x - outerRadius, origin.y - outerRadius, 2.f * outerRadius, 2.f * outerRadius, -halfPi, halfPi, 0.f);
+    g.setColour(BASE_COLOR);
+    g.fillPath(halfCircle);
+    g.setColour(edgeColour);
+    g.strokePath(halfCircle, juce::PathStrokeType(1.f));
+
+    // Level arcs every 12 dB
+    g.setColour(juce::Colours::grey);
+    for (float db = -12.f; db > PolarAnalyzer::floorDb; db -= 12.f)
+    {
+        juce::Path arc;
+        const float radius = (1.f - db / PolarAnalyzer::floorDb) * outerRadius;
+        arc.addCentredArc(origin.x, origin.y, radius, radius, 0.f, -halfPi, halfPi, true);
+        g.strokePath(arc, juce::PathStrokeType(1.f));
+    }
+
+    // Radial lines and labels for the side, left, mid and right positions
+    const std::array<juce::String, 5> labels { "S", "L", "M", "R", "S" };
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        const float angle = -halfPi + static_cast<float>(i) * halfPi / 2.f;
+        g.setColour(juce::Colours::grey);
+        g.drawLine(juce::Line<float>(origin, polarToScreen(angle, 1.f)), 1);
+
+        const auto labelCentre = polarToScreen(angle, 1.f + 10.f / outerRadius);
+        g.setColour(BASE_COLOR);
+        g.drawText(labels[i], juce::Rectangle<float>(20.f, 10.f).withCentre(labelCentre), juce::Justification::centred);
+    }
+}
+
+void Goniometer::renderPolarLevels()
+{
+    if (!phosphorImage.isValid())
+        return;
+
+    constexpr int numSectors = PolarFrame::numSectors;
+    const float sectorWidth = juce::MathConstants<float>::pi / static_cast<float>(numSectors);
+    const float firstAngle = -juce::MathConstants<float>::halfPi;
+
+    // One closed outline over every sector, stepping at the sector edges
+    const auto origin = polarToScreen(0.f, 0.f);
+    polarOutline.startNewSubPath(origin);
+    for (int sector = 0; sector < numSectors; ++sector)
+    {
+        const float level = polarFrame.levels[static_cast<size_t>(sector)];
+        polarOutline.lineTo(polarToScreen(firstAngle + sector * sectorWidth, level));
+        polarOutline.lineTo(polarToScreen(firstAngle + (sector + 1) * sectorWidth, level));
+    }
+    polarOutline.lineTo(origin);
+
+    phosphorImage.clear(phosphorImage.getBounds());
+
+    // The area inside the outline is not a column span, so it is still filled as a path,
+    // but only when the levels change rather than on every paint
+    {
+        juce::Path area;
+        area.preallocateSpace(3 * static_cast<int>(polarOutline.points.size()));
+        area.startNewSubPath(polarOutline.points.front());
+        for (size_t i = 1; i < polarOutline.points.size(); ++i)
+            area.lineTo(polarOutline.points[i]);
+        area.closeSubPath();
+
+        juce::Graphics context(phosphorImage);
+        context.setColour(pathColourOutside.withAlpha(0.6f));
+        context.fillPath(area);
+    }
+
+    juce::Image::BitmapData data(phosphorImage, juce::Image::BitmapData::readWrite);
+    polarRenderer.strokePolyline(data, polarOutline, pathColourOutside);
+
+    // Held peaks as short segments across their sectors
+    for (int sector = 0; sector < numSectors; ++sector)
+    {
+        const float hold = polarFrame.holds[static_cast<size_t>(sector)];
+        if (hold <= 0.f)
+            continue;
+
+        polarRenderer.strokeLine(data,
+            polarToScreen(firstAngle + sector * sectorWidth, hold),
+            polarToScreen(firstAngle + (sector + 1) * sectorWidth, hold),
+            pathColourInside, 1.5f);
+    }
+
+    polarLevelsStale = false;
 }
 
 void Goniometer::updateCoeff(float new_db)
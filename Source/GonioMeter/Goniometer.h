@@ -2,6 +2,12 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../Constants.h"
+#include "StereoHeatmap.h"
+#include "GoniometerStream.h"
+#include "PointMapping.h"
+#include "PolarAnalyzer.h"
+#include "../Rendering/PolylineRenderer.h"
+#include "../Profiling/PaintProfiler.h"
 
 //==============================================================================
 template<typename T>
@@ -81,8 +87,17 @@ private:
 //==============================================================================
 struct Goniometer : juce::Component
 {
+    // Display modes of the goniometer
+    enum Mode
+    {
+        Phosphor, // Latest samples with phosphor persistence
+        Heatmap, // Distribution of the samples over the heatmap window
+        PolarSample, // Latest samples by stereo position and level, with phosphor persistence
+        PolarLevel // Peak level of every stereo position with peak hold
+    };
+
     // Constructor
-    Goniometer(juce::AudioBuffer<float>& bufferInput);
+    Goniometer(GoniometerStream& streamInput, StereoHeatmap& heatmapInput, PolarAnalyzer& polarInput);
 
     // Paint method override
     void paint(juce::Graphics& g) override;
@@ -90,24 +105,109 @@ struct Goniometer : juce::Component
     // Resized method override
     void resized() override;
 
-    // Update method to update the visualization with new audio data
-    void update(juce::AudioBuffer<float>& buffer);
+    // Registers interest in the analysis of the current mode while the goniometer is visible
+    void visibilityChanged() override;
+
+    // Update method to plot the latest audio data into the phosphor image
+    void update();
 
     // Method to update the visualization scaling coefficient
     void updateCoeff(float new_db);
 
+    // Method to switch between the display modes
+    void setMode(Mode newMode);
+
+    // Method to follow the signal level instead of the scaling coefficient in the phosphor mode
+    void setAutoGain(bool shouldFollowLevel);
+
+    static constexpr float persistenceMs = 80.f; // Time for the phosphor to fade to 1/e
+    static constexpr float frameRate = 60.f; // Rate at which update is called, in Hz
+
+    static constexpr float autoGainAttackMs = 20.f; // Time constant of a rising envelope
+    static constexpr float autoGainReleaseMs = 2000.f; // Time constant of a falling envelope
+    static constexpr float autoGainTarget = 0.8f; // Fraction of the radius the envelope is scaled to
+    static constexpr float autoGainMinScale = 0.5f; // Lowest automatic scaling factor
+    static constexpr float autoGainMaxScale = 32.f; // Highest automatic scaling factor, about +30 dB
+    static constexpr float autoGainFloorDb = -60.f; // Envelope below which the scaling factor is held
+
 private:
     // Helper method to draw the background
     void drawBackground(juce::Graphics& g);
 
-    // Reference to the audio buffer
-    juce::AudioBuffer<float>& buffer;
+    // Helper method to draw the half circle background of the polar modes
+    void drawPolarBackground(juce::Graphics& g);
+
+    // Renders the sector levels and holds of the polar level mode into the phosphor image
+    void renderPolarLevels();
+
+    // Returns the screen position of a normalised polar radius at the given angle
+    juce::Point<float> polarToScreen(float angle, float radius) const;
+
+    // Adds the latest points of the stream to the accumulation buffer as additive points
+    void plotSamples();
+
+    // Adds the latest points of the polar analyzer to the accumulation buffer
+    void plotPolarSamples();
+
+    // Adds the points in pointsX and pointsY to the accumulation buffer, spreading each over four pixels
+    void splatPoints(int numPoints);
+
+    // Moves the envelope towards the M/S peak of the latest frame and derives the automatic scaling factor
+    void updateAutoGain(float framePeak);
+
+    // Decays the accumulation buffer and colour maps it into the phosphor image in one pass,
+    // returns whether any pixel changed
+    bool renderPhosphor();
+
+    // Colour maps the latest heatmap grid into the heatmap image, returns whether any pixel changed
+    bool renderHeatmap();
 
-    // Internal buffer for processing
-    juce::AudioBuffer<float> internalBuffer;
+    // Fills the colour lookup table from the path colours
+    void buildColourMap();
 
-    // Path for drawing the visualization
-    juce::Path p;
+    // Reference to the point stream produced on the analysis thread
+    GoniometerStream& stream;
+
+    // Latest frame pulled from the stream, plotted again until a newer one arrives
+    GoniometerFrame points;
+
+    // Screen positions of the points of the latest frame
+    std::array<float, GoniometerFrame::pointBudget> pointsX, pointsY;
+
+    // Reference to the heatmap accumulated on the analysis thread
+    StereoHeatmap& heatmap;
+
+    // Current display mode
+    Mode mode = Phosphor;
+
+    // Registration with the analysis the current mode draws, released when hidden or destroyed
+    InterestRegistration interestRegistration;
+
+    // Reference to the polar analysis running on the analysis thread
+    PolarAnalyzer& polar;
+
+    // Latest frame pulled from the polar analyzer
+    PolarFrame polarFrame;
+
+    // Outline of the sector levels, its rasteriser, and a flag indicating that the image does not show the levels
+    Polyline polarOutline;
+    PolylineRenderer polarRenderer;
+    bool polarLevelsStale = true;
+
+    // Latest grid pulled from the heatmap and the image it is colour mapped into
+    StereoHeatmap::Grid heatmapGrid;
+    juce::Image heatmapImage { juce::Image::ARGB, StereoHeatmap::gridSize, StereoHeatmap::gridSize, true };
+
+    // Phosphor energy of every pixel, decayed each frame and colour mapped into phosphorImage
+    std::vector<float> accumulation;
+
+    // Image holding the colour mapped phosphor, drawn over the background
+    juce::Image phosphorImage;
+
+    // Colour lookup table from phosphor energy to premultiplied pixels
+    static constexpr int colourMapSize = 1024;
+    static constexpr float colourMapRange = 4.f; // Energy mapped to the last entry of the table
+    std::array<juce::PixelARGB, colourMapSize> colourMap;
 
     // Width and height of the component
     int w, h;
@@ -121,8 +221,15 @@ private:
     // Scaling factor for the visualization
     float scale;
 
+    // Automatic gain state: the smoothed M/S peak and the scaling factor derived from it
+    bool autoGain = false;
+    float envelope = 0.f;
+    float autoScale = 1.f;
+
     // Colors for edge, inside, and outside paths
     juce::Colour edgeColour { 0xffd2d2d2 };
     juce::Colour pathColourInside { 0xffd2d2d2 };
     juce::Colour pathColourOutside { 0xff48bde8 };
+
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
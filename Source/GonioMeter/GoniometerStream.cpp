@@ -0,0 +1,57 @@
+#include "GoniometerStream.h"
+
+//==============================================================================
+// Implementation for the GoniometerStream class
+void GoniometerStream::prepare(double sampleRate)
+{
+    constexpr int pointBudget = GoniometerFrame::pointBudget;
+
+    // Thinning keeps real sample positions, so the trace keeps its shape without a filter
+    const double windowSamples = sampleRate * windowMs / 1000.0;
+    decimation = juce::jmax(1, static_cast<int>(std::ceil(windowSamples / pointBudget)));
+    windowPoints = juce::jlimit(1, pointBudget, juce::roundToInt(windowSamples / decimation));
+    publishInterval = juce::jmax(1, juce::roundToInt(sampleRate / publishRate));
+
+    history.left.fill(0.f);
+    history.right.fill(0.f);
+    writeIndex = 0;
+    decimationPhase = 0;
+    samplesSincePublish = 0;
+}
+
+void GoniometerStream::process(const float* left, const float* right, int numSamples)
+{
+    constexpr int pointBudget = GoniometerFrame::pointBudget;
+
+    int i = decimationPhase;
+    for (; i < numSamples; i += decimation)
+    {
+        history.left[static_cast<size_t>(writeIndex)] = left[i];
+        history.right[static_cast<size_t>(writeIndex)] = right[i];
+        writeIndex = (writeIndex + 1) % pointBudget;
+    }
+
+    // Carry the stride over into the next chunk
+    decimationPhase = i - numSamples;
+
+    samplesSincePublish += numSamples;
+    if (samplesSincePublish < publishInterval)
+        return;
+
+    // Keep the overshoot so frames follow publishRate whatever the chunk size. A chunk longer
+    // than the interval can only publish once, so the carry is kept below one interval.
+    samplesSincePublish = juce::jmin(samplesSincePublish - publishInterval, publishInterval - 1);
+
+    // Unroll the last window of the ring in chronological order
+    const int start = (writeIndex - windowPoints + pointBudget) % pointBudget;
+    const int size1 = juce::jmin(windowPoints, pointBudget - start);
+    const int size2 = windowPoints - size1;
+
+    std::copy_n(history.left.begin() + start, size1, frame.left.begin());
+    std::copy_n(history.right.begin() + start, size1, frame.right.begin());
+    std::copy_n(history.left.begin(), size2, frame.left.begin() + size1);
+    std::copy_n(history.right.begin(), size2, frame.right.begin() + size1);
+    frame.numPoints = windowPoints;
+
+    frameFifo.push(frame);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Fifo.h"
+#include "../Analysis/AnalysisThread.h"
+
+//==============================================================================
+// Stereo points of the latest goniometer window, oldest first
+struct GoniometerFrame
+{
+    static constexpr int pointBudget = 2048; // Most points drawn per frame
+
+    std::array<float, pointBudget> left; // Left sample of each point
+    std::array<float, pointBudget> right; // Right sample of each point
+    int numPoints = 0; // Number of valid points
+};
+
+//==============================================================================
+// Display stream of the goniometer, produced on the analysis thread. Frames always
+// cover the same span of audio, whatever the host block size, and the samples are
+// thinned to a fixed point budget so the cost of drawing them does not grow with
+// the sample rate.
+struct GoniometerStream : StereoAnalysis
+{
+    static constexpr float windowMs = 50.f; // Span of audio drawn per frame
+    static constexpr float publishRate = 60.f; // Frames published per second, the goniometer frame rate
+
+    // Derives the decimation factor, window and publishing interval for the sample rate
+    void prepare(double sampleRate) override;
+
+    // Thins the samples into the point history and publishes frames, called on the analysis thread
+    void process(const float* left, const float* right, int numSamples) override;
+
+    // Retrieves the oldest published frame from the FIFO
+    bool getFrame(GoniometerFrame& frame) { return frameFifo.pull(frame); }
+
+    // Returns the number of frames waiting in the FIFO
+    int getNumFramesAvailable() const { return frameFifo.getNumAvailableForReading(); }
+
+private:
+    GoniometerFrame history; // Ring of the latest points, used in place of a frame
+    GoniometerFrame frame; // Frame assembled in chronological order before publishing
+    int writeIndex = 0; // Write index into history
+    int decimation = 1; // Every decimation-th sample becomes a point
+    int decimationPhase = 0; // Samples to skip before the next point
+    int windowPoints = GoniometerFrame::pointBudget; // Number of points in a window
+    int publishInterval = 735; // Number of samples between published frames
+    int samplesSincePublish = 0; // Number of samples since the last published frame
+
+    FifoSpectrumAnalyzer<GoniometerFrame> frameFifo; // FIFO for publishing frames to the GUI
+};
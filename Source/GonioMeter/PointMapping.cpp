@@ -0,0 +1,38 @@
+#include "PointMapping.h"
+
+//==============================================================================
+// Implementation for the PointMapping class
+float PointMapping::process(const float* left, const float* right, int numPoints, float* xs, float* ys) const
+{
+    // Like the statistics kernel, every lane keeps its own peak and the body has no
+    // branches, so the compiler can map the lanes onto SIMD registers
+    constexpr int numLanes = 8;
+
+    std::array<float, numLanes> peaks {};
+    const float x0 = centreX;
+    const float y0 = centreY;
+    const float k = pixelsPerUnit;
+
+    auto map = [&](int lane, int i)
+    {
+        const float side = left[i] - right[i];
+        const float mid = left[i] + right[i];
+        xs[i] = x0 + side * k;
+        ys[i] = y0 - mid * k;
+
+        // The peak is the first argument, so a NaN sample never replaces it
+        peaks[lane] = juce::jmax(peaks[lane], std::abs(side), std::abs(mid));
+    };
+
+    int i = 0;
+    for (; i + numLanes <= numPoints; i += numLanes)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+            map(lane, i + lane);
+    }
+
+    for (; i < numPoints; ++i)
+        map(0, i);
+
+    return *std::max_element(peaks.begin(), peaks.end());
+}
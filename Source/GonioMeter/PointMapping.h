@@ -0,0 +1,18 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Maps planar L/R samples straight to goniometer screen points in a single pass:
+// S = L - R runs along x and M = L + R up the y axis around the centre. The mapping
+// is fixed for a frame, so any renderer can take the point arrays it produces.
+struct PointMapping
+{
+    float centreX = 0.f; // Screen position of S = 0
+    float centreY = 0.f; // Screen position of M = 0
+    float pixelsPerUnit = 1.f; // Pixels per unit of S or M
+
+    // Writes the screen position of every sample to xs and ys and returns the
+    // largest M/S magnitude of the block; non-finite samples are ignored by the peak
+    float process(const float* left, const float* right, int numPoints, float* xs, float* ys) const;
+};
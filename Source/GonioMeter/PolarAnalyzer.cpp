@@ -0,0 +1,140 @@
+#include "PolarAnalyzer.h"
+
+//==============================================================================
+// Implementation for the PolarAnalyzer class
+void PolarAnalyzer::prepare(double sampleRate)
+{
+    constexpr int pointBudget = PolarFrame::pointBudget;
+
+    const double windowSamples = sampleRate * GoniometerStream::windowMs / 1000.0;
+    decimation = juce::jmax(1, static_cast<int>(std::ceil(windowSamples / pointBudget)));
+    windowPoints = juce::jlimit(1, pointBudget, juce::roundToInt(windowSamples / decimation));
+    publishInterval = juce::jmax(1, juce::roundToInt(sampleRate / GoniometerStream::publishRate));
+
+    const float framesPerSecond = GoniometerStream::publishRate;
+    releasePerFrame = releaseDbPerSecond / (-floorDb * framesPerSecond);
+    holdFrames = juce::roundToInt(holdMs * framesPerSecond / 1000.f);
+
+    historyAngles.fill(0.f);
+    historyLevels.fill(0.f);
+    sectorPeaks.fill(0.f);
+    holdCounters.fill(0);
+    frame.levels.fill(0.f);
+    frame.holds.fill(0.f);
+    writeIndex = 0;
+    decimationPhase = 0;
+    samplesSincePublish = 0;
+}
+
+void PolarAnalyzer::process(const float* left, const float* right, int numSamples)
+{
+    constexpr int pointBudget = PolarFrame::pointBudget;
+    constexpr int numSectors = PolarFrame::numSectors;
+
+    // The analysis thread never hands over more than a chunk at a time
+    jassert(numSamples <= AnalysisThread::chunkSize);
+    numSamples = juce::jmin(numSamples, AnalysisThread::chunkSize);
+
+    computePolar(left, right, numSamples, angles.data(), levels.data());
+
+    // Every sample counts towards the sector peaks
+    const float sectorsPerRadian = static_cast<float>(numSectors) / juce::MathConstants<float>::pi;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int sector = juce::jlimit(0, numSectors - 1,
+            static_cast<int>((angles[static_cast<size_t>(i)] + juce::MathConstants<float>::halfPi) * sectorsPerRadian));
+        sectorPeaks[static_cast<size_t>(sector)] = juce::jmax(sectorPeaks[static_cast<size_t>(sector)], levels[static_cast<size_t>(i)]);
+    }
+
+    // Only the thinned samples become points
+    int i = decimationPhase;
+    for (; i < numSamples; i += decimation)
+    {
+        historyAngles[static_cast<size_t>(writeIndex)] = angles[static_cast<size_t>(i)];
+        historyLevels[static_cast<size_t>(writeIndex)] = levels[static_cast<size_t>(i)];
+        writeIndex = (writeIndex + 1) % pointBudget;
+    }
+
+    decimationPhase = i - numSamples;
+
+    samplesSincePublish += numSamples;
+    if (samplesSincePublish < publishInterval)
+        return;
+
+    // Keep the overshoot so frames follow publishRate whatever the chunk size, as the release
+    // and hold are counted in frames at that rate. A chunk longer than the interval can only
+    // publish once, so the carry is kept below one interval.
+    samplesSincePublish = juce::jmin(samplesSincePublish - publishInterval, publishInterval - 1);
+
+    // Sector levels fall at the release rate, holds are kept for holdFrames and then fall with them
+    for (size_t sector = 0; sector < static_cast<size_t>(numSectors); ++sector)
+    {
+        const float radius = levelToRadius(sectorPeaks[sector]);
+        frame.levels[sector] = juce::jmax(radius, frame.levels[sector] - releasePerFrame);
+
+        if (radius >= frame.holds[sector])
+        {
+            frame.holds[sector] = radius;
+            holdCounters[sector] = holdFrames;
+        }
+        else if (holdCounters[sector] > 0)
+        {
+            --holdCounters[sector];
+        }
+        else
+        {
+            frame.holds[sector] = juce::jmax(frame.levels[sector], frame.holds[sector] - releasePerFrame);
+        }
+    }
+
+    sectorPeaks.fill(0.f);
+
+    // Convert the last window of points to positions, oldest first
+    const int start = (writeIndex - windowPoints + pointBudget) % pointBudget;
+    for (int point = 0; point < windowPoints; ++point)
+    {
+        const auto index = static_cast<size_t>((start + point) % pointBudget);
+        const float radius = levelToRadius(historyLevels[index]);
+        frame.x[static_cast<size_t>(point)] = radius * std::sin(historyAngles[index]);
+        frame.y[static_cast<size_t>(point)] = radius * std::cos(historyAngles[index]);
+    }
+
+    frame.numPoints = windowPoints;
+    frameFifo.push(frame);
+}
+
+float PolarAnalyzer::fastAtan2(float y, float x)
+{
+    // Minimax polynomial for atan on [0, 1], extended to the full circle by symmetry.
+    // The selections compile to blends rather than branches.
+    const float ax = std::abs(x);
+    const float ay = std::abs(y);
+    const float a = juce::jmin(ax, ay) / juce::jmax(juce::jmax(ax, ay), 1.0e-30f);
+    const float s = a * a;
+    float r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+
+    r = ay > ax ? juce::MathConstants<float>::halfPi - r : r;
+    r = x < 0.f ? juce::MathConstants<float>::pi - r : r;
+    return y < 0.f ? -r : r;
+}
+
+void PolarAnalyzer::computePolar(const float* left, const float* right, int numSamples, float* angles, float* levels)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float l = left[i];
+        const float r = right[i];
+
+        // Fold the polarity, so M is never negative and the angle stays on the upper half circle
+        const float polarity = l + r < 0.f ? -1.f : 1.f;
+        angles[i] = fastAtan2((r - l) * polarity, (l + r) * polarity);
+
+        // Equal to hypot(M, S) / 2, so a mono signal reads its sample level
+        levels[i] = std::sqrt((l * l + r * r) * 0.5f);
+    }
+}
+
+float PolarAnalyzer::levelToRadius(float level)
+{
+    return juce::jlimit(0.f, 1.f, 1.f - juce::Decibels::gainToDecibels(level, floorDb) / floorDb);
+}
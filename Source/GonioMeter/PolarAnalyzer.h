@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Fifo.h"
+#include "../Analysis/AnalysisThread.h"
+#include "GoniometerStream.h"
+
+//==============================================================================
+// Latest output of the polar analyzer. Radii are normalised levels, 0 at
+// PolarAnalyzer::floorDb and 1 at 0 dB, and positions use the upper half of the
+// unit circle: M straight up, L to the upper left, R to the upper right and S to the sides.
+struct PolarFrame
+{
+    static constexpr int numSectors = 90; // Sectors of 2 degrees over the half circle
+    static constexpr int pointBudget = GoniometerFrame::pointBudget; // Most points drawn per frame
+
+    std::array<float, pointBudget> x; // Horizontal position of each point
+    std::array<float, pointBudget> y; // Vertical position of each point, upwards
+    int numPoints = 0; // Number of valid points
+
+    std::array<float, numSectors> levels {}; // Decaying peak level of each sector, from -90 to +90 degrees
+    std::array<float, numSectors> holds {}; // Held peak level of each sector
+};
+
+//==============================================================================
+// Polar stereo analysis on the analysis thread, like the polar displays of broadcast
+// meters: the angle of a sample is its stereo position and its radius its level.
+// Polarity is folded, so a sample and its inverse share a position. Every sample is
+// binned into angular sectors with peak hold, and a thinned window of the samples is
+// published as points, using the same window and point budget as the GoniometerStream.
+struct PolarAnalyzer : StereoAnalysis
+{
+    static constexpr float floorDb = -48.f; // Level at the centre of the display
+    static constexpr float holdMs = 1000.f; // Time a sector peak is held
+    static constexpr float releaseDbPerSecond = 24.f; // Fall rate of the sector levels and released holds
+
+    // Derives the decimation factor, window and publishing interval for the sample rate
+    void prepare(double sampleRate) override;
+
+    // Computes the polar position of every sample, bins them into sectors and publishes frames
+    void process(const float* left, const float* right, int numSamples) override;
+
+    // Retrieves the oldest published frame from the FIFO
+    bool getFrame(PolarFrame& destination) { return frameFifo.pull(destination); }
+
+    // Approximation of atan2(y, x) with an error below 0.0003 radians. It has no branches,
+    // so loops calling it can be vectorised
+    static float fastAtan2(float y, float x);
+
+    // Computes the folded stereo angle (-pi/2 to pi/2, 0 for mono, negative towards L) and the
+    // level, sqrt((L^2 + R^2) / 2), of every sample in one vectorisable pass
+    static void computePolar(const float* left, const float* right, int numSamples, float* angles, float* levels);
+
+    // Converts a level to the normalised radius of the display
+    static float levelToRadius(float level);
+
+private:
+    std::array<float, AnalysisThread::chunkSize> angles; // Angle of every sample of the chunk
+    std::array<float, AnalysisThread::chunkSize> levels; // Level of every sample of the chunk
+    std::array<float, PolarFrame::numSectors> sectorPeaks {}; // Highest level of each sector since the last frame
+    std::array<int, PolarFrame::numSectors> holdCounters {}; // Frames each sector hold is kept
+
+    std::array<float, PolarFrame::pointBudget> historyAngles {}; // Ring of the angles of the latest points
+    std::array<float, PolarFrame::pointBudget> historyLevels {}; // Ring of the levels of the latest points
+    int writeIndex = 0; // Write index into the history rings
+    int decimation = 1; // Every decimation-th sample becomes a point
+    int decimationPhase = 0; // Samples to skip before the next point
+    int windowPoints = PolarFrame::pointBudget; // Number of points in a window
+    int publishInterval = 735; // Number of samples between published frames
+    int samplesSincePublish = 0; // Number of samples since the last published frame
+    float releasePerFrame = 0.01f; // Normalised radius the levels fall by per frame
+    int holdFrames = 60; // Frames a sector peak is held
+
+    PolarFrame frame; // Frame assembled before publishing, also holding the sector state
+    FifoSpectrumAnalyzer<PolarFrame> frameFifo; // FIFO for publishing frames to the GUI
+};
@@ -0,0 +1,49 @@
+#include "StereoHeatmap.h"
+
+//==============================================================================
+// Implementation for the StereoHeatmap class
+StereoHeatmap::StereoHeatmap()
+{
+    // Every grid in the FIFO is allocated up front, so publishing only copies
+    grid.assign(static_cast<size_t>(gridSize * gridSize), 0.f);
+    gridFifo.prepare(grid.size());
+}
+
+void StereoHeatmap::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    publishInterval = juce::jmax(1, juce::roundToInt(sampleRate / publishRate));
+    samplesSincePublish = 0;
+    std::fill(grid.begin(), grid.end(), 0.f);
+}
+
+void StereoHeatmap::process(const float* left, const float* right, int numSamples)
+{
+    // Decay the whole grid for the duration of the chunk in one vectorised pass
+    const auto window = juce::jmax(0.1f, windowSeconds.load());
+    const auto decay = static_cast<float>(std::exp(-numSamples / (currentSampleRate * window)));
+    juce::FloatVectorOperations::multiply(grid.data(), decay, static_cast<int>(grid.size()));
+
+    // Map S to the columns and M to the rows, +M at the top
+    const float binsPerUnit = static_cast<float>(gridSize) / (2.f * getRange());
+    const float centre = static_cast<float>(gridSize) / 2.f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float column = centre + (left[i] - right[i]) * binsPerUnit;
+        const float row = centre - (left[i] + right[i]) * binsPerUnit;
+
+        // Samples beyond the edge, including non-finite ones, are not counted
+        if (column >= 0.f && row >= 0.f && column < static_cast<float>(gridSize) && row < static_cast<float>(gridSize))
+            grid[static_cast<size_t>(row) * gridSize + static_cast<size_t>(column)] += 1.f;
+    }
+
+    samplesSincePublish += numSamples;
+    if (samplesSincePublish >= publishInterval)
+    {
+        // Keep the overshoot so grids follow publishRate whatever the chunk size. A chunk longer
+        // than the interval can only publish once, so the carry is kept below one interval.
+        samplesSincePublish = juce::jmin(samplesSincePublish - publishInterval, publishInterval - 1);
+        gridFifo.push(grid);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Fifo.h"
+#include "../Constants.h"
+#include "../Analysis/AnalysisThread.h"
+
+//==============================================================================
+// 2D histogram of the (S, M) positions of the samples, accumulated on the analysis
+// thread over an exponentially decaying window. The grid has a fixed size whatever the
+// sample count, and the GUI only receives copies of it to colour map.
+struct StereoHeatmap : StereoAnalysis
+{
+    static constexpr int gridSize = 128; // Bins along each axis
+    static constexpr float publishRate = 30.f; // Grids published per second
+    using Grid = std::vector<float>; // gridSize * gridSize bins, row by row from +M to -M
+
+    StereoHeatmap();
+
+    // Returns the S or M magnitude at the edge of the grid, the goniometer circle at 100% scale
+    static float getRange() { return juce::Decibels::decibelsToGain(MAX_DECIBELS) / 2.f; }
+
+    // Clears the grid and derives the publishing interval for the sample rate
+    void prepare(double sampleRate) override;
+
+    // Bins the samples and decays the grid, called on the analysis thread
+    void process(const float* left, const float* right, int numSamples) override;
+
+    // Sets the time constant of the decaying window in seconds, called from the GUI
+    void setWindow(float seconds) { windowSeconds.store(seconds); }
+
+    // Retrieves the oldest published grid from the FIFO
+    bool getGrid(Grid& destination) { return gridFifo.pull(destination); }
+
+private:
+    Grid grid; // Accumulated bins
+    double currentSampleRate = 44100.0; // Sample rate of the incoming samples
+    int publishInterval = 1470; // Number of samples between published grids
+    int samplesSincePublish = 0; // Number of samples since the last published grid
+
+    std::atomic<float> windowSeconds { 5.f }; // Time constant of the window, set by the GUI
+    FifoSpectrumAnalyzer<Grid> gridFifo; // FIFO for publishing grids to the GUI
+};
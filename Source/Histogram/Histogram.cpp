@@ -1,12 +1,95 @@
 
 #include "Histogram.h"
 
+//==============================================================================
+// Implementation for the HistoryBin class
+HistoryBin HistoryBin::combine(const HistoryBin& a, const HistoryBin& b)
+{
+    HistoryBin result;
+    result.min = juce::jmin(a.min, b.min);
+    result.max = juce::jmax(a.max, b.max);
+    result.mean = (a.mean + b.mean) / 2.f;
+    return result;
+}
+
+//==============================================================================
+// Implementation for the LevelHistory class
+LevelHistory::LevelHistory()
+{
+    for (auto& level : levels)
+        level.bins.resize(levelCapacity);
+
+    clear();
+}
+
+void LevelHistory::clear()
+{
+    for (auto& level : levels)
+    {
+        std::fill(level.bins.begin(), level.bins.end(), HistoryBin());
+        level.writeIndex = 0;
+        level.numBins = 0;
+        level.hasPending = false;
+    }
+}
+
+int LevelHistory::push(float value)
+{
+    HistoryBin bin;
+    bin.min = bin.max = bin.mean = juce::jmax(value, NEGATIVE_INFINITY);
+
+    int levelIndex = 0;
+    while (levelIndex < numLevels)
+    {
+        auto& level = levels[levelIndex];
+        level.bins[level.writeIndex] = bin;
+        level.writeIndex = (level.writeIndex + 1) % levelCapacity;
+        level.numBins = juce::jmin(level.numBins + 1, levelCapacity);
+        ++levelIndex;
+
+        // Every second bin completes a pair for the next level
+        if (!level.hasPending)
+        {
+            level.pending = bin;
+            level.hasPending = true;
+            break;
+        }
+
+        bin = HistoryBin::combine(level.pending, bin);
+        level.hasPending = false;
+    }
+
+    return levelIndex;
+}
+
+void LevelHistory::read(int level, int numBins, std::vector<HistoryBin>& out) const
+{
+    auto& source = levels[juce::jlimit(0, numLevels - 1, level)];
+    out.assign(static_cast<size_t>(juce::jmax(0, numBins)), HistoryBin());
+
+    // Copy the newest bins to the end of out, walking backwards through the ring
+    const int available = juce::jmin(numBins, source.numBins);
+    for (int i = 0; i < available; ++i)
+    {
+        const int index = (source.writeIndex - 1 - i + levelCapacity) % levelCapacity;
+        out[static_cast<size_t>(numBins - 1 - i)] = source.bins[static_cast<size_t>(index)];
+    }
+}
+
+HistoryBin LevelHistory::getLatest(int level) const
+{
+    auto& source = levels[juce::jlimit(0, numLevels - 1, level)];
+    return source.bins[static_cast<size_t>((source.writeIndex - 1 + levelCapacity) % levelCapacity)];
+}
+
 //==============================================================================
 // Implementation for the Histogram class
 Histogram::Histogram(const juce::String& titleInput) : title(titleInput) {}
 
 void Histogram::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Histograms);
+
     // Fill the background with a rounded rectangle using the base color
     g.setColour(BASE_COLOR);
     g.fillRoundedRectangle(getLocalBounds().toFloat(), 4);
@@ -17,8 +100,27 @@ void Histogram::paint(juce::Graphics& g)
     // Draw the title text at the bottom of the component, centered horizontally
     g.drawText(title, getLocalBounds().removeFromBottom(20), juce::Justification::centred);
 
-    // Display the path representing the histogram waveform
-    displayPath(g, getLocalBounds().toFloat());
+    // Blit the history ring, oldest column first: the part right of the write position
+    // is drawn on the left, followed by the part that has already wrapped around
+    if (historyImage.isValid())
+    {
+        const int width = historyImage.getWidth();
+        const int height = historyImage.getHeight();
+        g.drawImage(historyImage, 0, 0, width - writeX, height, writeX, 0, width - writeX, height);
+        g.drawImage(historyImage, width - writeX, 0, writeX, height, 0, 0, writeX, height);
+    }
+
+    // Show the time span covered by the width when zoomed out
+    if (zoomLevel > 0)
+    {
+        const auto seconds = getWidth() * std::pow(2.f, static_cast<float>(zoomLevel)) / updateRate;
+        const auto span = seconds < 120.f ? juce::String(juce::roundToInt(seconds)) + " s"
+            : seconds < 7200.f ? juce::String(seconds / 60.f, 1) + " min"
+            : juce::String(seconds / 3600.f, 1) + " h";
+        g.setColour(juce::Colours::white.withAlpha(0.7f));
+        g.setFont(12.f);
+        g.drawText(span, getLocalBounds().reduced(6, 4).removeFromTop(14), juce::Justification::topRight);
+    }
 
     // Create a border path with rounded corners to outline the component
     Path border;
@@ -33,44 +135,379 @@ void Histogram::paint(juce::Graphics& g)
 
 void Histogram::resized()
 {
-    // Resize the circular buffer to match the width of the component
-    buffer.resize(getWidth(), NEGATIVE_INFINITY);
+    // The history is kept independently of the size, so resizing only redraws it
+    if (getLocalBounds().isEmpty())
+    {
+        historyImage = {};
+        return;
+    }
+
+    // The gradient only depends on the height, so it is computed once per size
+    const juce::ColourGradient gradient(HIGHLIGHT_COLOR.withAlpha(0.8f),
+        0.f, 0.f,
+        BASE_COLOR.withAlpha(0.3f),
+        0.f, static_cast<float>(getHeight()),
+        false);
+    gradientRows.resize(static_cast<size_t>(getHeight()));
+    for (int row = 0; row < getHeight(); ++row)
+        gradientRows[static_cast<size_t>(row)] = gradient.getColourAtPosition((row + 0.5) / getHeight()).getPixelARGB();
+
+    historyImage = juce::Image(juce::Image::ARGB, getWidth(), getHeight(), true);
+    rebuildImage();
 }
 
 void Histogram::mouseDown(const juce::MouseEvent& e)
 {
-    // Clear the circular buffer when the mouse is clicked
-    buffer.clear(NEGATIVE_INFINITY);
+    // Clear the history when the mouse is clicked
+    history.clear();
+    rebuildImage();
+    repaint();
+}
+
+void Histogram::mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+{
+    // Scrolling up zooms in towards the update rate, scrolling down shows a longer span
+    const int step = wheel.deltaY > 0.f ? -1 : wheel.deltaY < 0.f ? 1 : 0;
+    const int newZoomLevel = juce::jlimit(0, LevelHistory::numLevels - 1, zoomLevel + step);
+
+    if (newZoomLevel != zoomLevel)
+    {
+        zoomLevel = newZoomLevel;
+        rebuildImage();
+        repaint();
+    }
 }
 
 void Histogram::update(float value)
 {
-    // Write the new value to the circular buffer
-    buffer.write(value);
-    // Trigger a repaint to update the display
-    repaint();
+    // Only a completed bin at the shown level adds a column
+    if (history.push(value) > zoomLevel && historyImage.isValid())
+    {
+        // Nothing is drawn behind another view, the image is rebuilt once it is shown
+        if (!isVisible())
+        {
+            imageIsStale = true;
+            return;
+        }
+
+        const auto bin = history.getLatest(zoomLevel);
+        drawColumn(writeX, bin);
+        writeX = (writeX + 1) % historyImage.getWidth();
+
+        // Every column scrolls, so a new column that differs from the previous one repaints the whole history
+        const std::array<int, 3> rows { mapToY(bin.max), mapToY(bin.min), mapToY(bin.mean) };
+        identicalColumns = rows == latestRows ? identicalColumns + 1 : 0;
+        latestRows = rows;
+
+        if (identicalColumns < historyImage.getWidth())
+            repaint();
+    }
+}
+
+void Histogram::visibilityChanged()
+{
+    if (isVisible() && imageIsStale)
+    {
+        rebuildImage();
+        repaint();
+    }
+}
+
+int Histogram::mapToY(float db) const
+{
+    return juce::roundToInt(mapToPosition(db));
+}
+
+float Histogram::mapToPosition(float db) const
+{
+    // Map decibel values to y-positions, MAX_DECIBELS at the top and NEGATIVE_INFINITY at the bottom
+    return juce::jmap(juce::jlimit(NEGATIVE_INFINITY, MAX_DECIBELS, db),
+        NEGATIVE_INFINITY, MAX_DECIBELS,
+        static_cast<float>(getHeight()), 0.f);
+}
+
+void Histogram::drawColumn(int x, const HistoryBin& bin)
+{
+    if (!historyImage.isValid() || x >= historyImage.getWidth())
+        return;
+
+    // Write the column straight into the pixels: clear the old column and fill the gradient
+    // below the maximum, with the top pixel partially covered
+    juce::Image::BitmapData data(historyImage, juce::Image::BitmapData::readWrite);
+    PolylineRenderer::clearColumn(data, x);
+    PolylineRenderer::fillColumn(data, x, mapToPosition(bin.max), gradientRows.data());
+
+    // Mark the mean when the bin spans more than one pixel
+    const int top = mapToY(bin.max);
+    if (mapToY(bin.min) - top > 1)
+    {
+        const auto meanRow = static_cast<float>(mapToY(bin.mean));
+        PolylineRenderer::blendSpan(data, x, meanRow, meanRow + 1.f, juce::Colours::white.withAlpha(0.6f).getPixelARGB());
+    }
+}
+
+void Histogram::rebuildImage()
+{
+    if (!historyImage.isValid())
+        return;
+
+    // Read one bin per column, oldest on the left, so the ring starts at column 0
+    const int width = historyImage.getWidth();
+    history.read(zoomLevel, width, visibleBins);
+
+    historyImage.clear(historyImage.getBounds());
+    for (int x = 0; x < width; ++x)
+    {
+        drawColumn(x, visibleBins[static_cast<size_t>(x)]);
+    }
+
+    writeX = 0;
+    identicalColumns = 0;
+    imageIsStale = false;
+}
+
+//==============================================================================
+// Implementation for the LevelDistribution class
+LevelDistribution::LevelDistribution()
+{
+    for (auto& bin : bins)
+        bin.store(0, std::memory_order_relaxed);
 }
 
-void Histogram::displayPath(juce::Graphics& g, juce::Rectangle<float> bounds)
+void LevelDistribution::prepare(double sampleRate)
 {
-    // Build the path to be displayed using the circular buffer data
-    juce::Path fill = buildPath(path, buffer, bounds);
+    // Decay is applied in steps of 100 ms of audio
+    decayStepLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+    samplesSinceDecay = 0;
+}
+
+void LevelDistribution::add(float levelDb, int numSamples)
+{
+    if (resetRequested.exchange(false))
+    {
+        for (auto& bin : bins)
+            bin.store(0, std::memory_order_relaxed);
+    }
+
+    // Digital silence would dominate the distribution, so it is not counted
+    if (levelDb > NEGATIVE_INFINITY && numSamples > 0)
+    {
+        auto index = juce::jlimit(0, numBins - 1, static_cast<int>((levelDb - NEGATIVE_INFINITY) / binWidthDb));
+        bins[index].fetch_add(static_cast<juce::uint64>(numSamples), std::memory_order_relaxed);
+    }
+
+    // A block longer than one step applies every step it covers
+    samplesSinceDecay += numSamples;
+    while (samplesSinceDecay >= decayStepLength)
+    {
+        samplesSinceDecay -= decayStepLength;
+        applyDecay();
+    }
+}
+
+void LevelDistribution::getCounts(Counts& destination) const
+{
+    for (int i = 0; i < numBins; ++i)
+        destination[i] = bins[i].load(std::memory_order_relaxed);
+}
+
+float LevelDistribution::getPercentile(const Counts& counts, float proportion)
+{
+    juce::uint64 total = 0;
+    for (auto count : counts)
+        total += count;
 
-    // Check if the path is not empty before proceeding to fill it
-    if (!fill.isEmpty())
+    if (total == 0)
+        return NEGATIVE_INFINITY;
+
+    // Walk the cumulative counts until the requested proportion is reached
+    const auto target = static_cast<juce::uint64>(proportion * static_cast<double>(total));
+    juce::uint64 cumulative = 0;
+    for (int i = 0; i < numBins; ++i)
     {
-        // Create a gradient for filling the path, from HIGHLIGHT_COLOR to BASE_COLOR
-        ColourGradient gradient(HIGHLIGHT_COLOR.withAlpha(0.8f),
-            bounds.getX(), bounds.getY(),
+        cumulative += counts[i];
+        if (cumulative > target)
+            return getBinLevel(i);
+    }
+
+    return getBinLevel(numBins - 1);
+}
+
+void LevelDistribution::applyDecay()
+{
+    auto halfLife = halfLifeSeconds.load();
+    if (halfLife <= 0.f)
+        return;
+
+    // The audio thread is the only writer, so a plain load and store is enough
+    const auto factor = std::pow(0.5, 0.1 / halfLife);
+    for (auto& bin : bins)
+    {
+        auto count = bin.load(std::memory_order_relaxed);
+        bin.store(static_cast<juce::uint64>(static_cast<double>(count) * factor), std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+// Implementation for the DistributionHistogram class
+DistributionHistogram::DistributionHistogram(LevelDistribution& distributionInput, const juce::String& titleInput) :
+    distribution(distributionInput),
+    title(titleInput)
+{
+}
+
+void DistributionHistogram::paint(juce::Graphics& g)
+{
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Histograms);
+
+    // Fill the background with a rounded rectangle using the base color
+    g.setColour(BASE_COLOR);
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4);
+
+    auto bounds = getLocalBounds().toFloat();
+    auto titleArea = bounds.removeFromBottom(20);
+    auto chartArea = bounds.reduced(2, 6);
+
+    // Scale the bars to the fullest bin
+    juce::uint64 maxCount = 0;
+    for (auto count : counts)
+        maxCount = juce::jmax(maxCount, count);
+
+    // Map dB values horizontally, NEGATIVE_INFINITY on the left and MAX_DECIBELS on the right
+    auto mapX = [chartArea](float db) { return juce::jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, chartArea.getX(), chartArea.getRight()); };
+
+    if (maxCount > 0)
+    {
+        const auto barWidth = chartArea.getWidth() / static_cast<float>(LevelDistribution::numBins);
+        juce::RectangleList<float> bars;
+
+        for (int i = 0; i < LevelDistribution::numBins; ++i)
+        {
+            if (counts[i] == 0)
+                continue;
+
+            auto height = chartArea.getHeight() * static_cast<float>(static_cast<double>(counts[i]) / static_cast<double>(maxCount));
+            bars.addWithoutMerging({ chartArea.getX() + i * barWidth, chartArea.getBottom() - height, juce::jmax(1.f, barWidth), height });
+        }
+
+        // Fill the bars with the same gradient as the level histogram
+        g.setGradientFill(juce::ColourGradient(HIGHLIGHT_COLOR.withAlpha(0.8f),
+            chartArea.getX(), chartArea.getY(),
             BASE_COLOR.withAlpha(0.3f),
-            bounds.getX(), bounds.getBottom(),
-            false);
+            chartArea.getX(), chartArea.getBottom(),
+            false));
+        g.fillRectList(bars);
+
+        if (showPercentiles)
+        {
+            // Mark the 10th, 50th and 95th percentiles of the level
+            g.setFont(11.f);
+            for (auto proportion : { 0.10f, 0.50f, 0.95f })
+            {
+                auto level = LevelDistribution::getPercentile(counts, proportion);
+                auto x = mapX(level);
 
-        // Set the fill type using the gradient
-        juce::FillType fillType(gradient);
-        g.setFillType(fillType);
+                g.setColour(juce::Colours::white.withAlpha(0.7f));
+                g.drawVerticalLine(juce::roundToInt(x), chartArea.getY(), chartArea.getBottom());
+
+                // Keep the label inside the chart by flipping it to the left of markers near the right edge
+                juce::Rectangle<float> labelArea(x + 2.f, chartArea.getY() + (proportion == 0.50f ? 14.f : 0.f), 60.f, 14.f);
+                auto justification = juce::Justification::centredLeft;
+                if (labelArea.getRight() > chartArea.getRight())
+                {
+                    labelArea.setX(x - 62.f);
+                    justification = juce::Justification::centredRight;
+                }
+
+                g.drawText("P" + juce::String(juce::roundToInt(proportion * 100.f)) + " " + juce::String(level, 1),
+                    labelArea,
+                    justification);
+            }
+        }
+    }
 
-        // Fill the path with the gradient
-        g.fillPath(fill);
+    // Draw the title text at the bottom of the component, centered horizontally
+    g.setColour(juce::Colours::white);
+    g.setFont(16.f);
+    g.drawText(title, titleArea, juce::Justification::centred);
+
+    // Create a border path with rounded corners to outline the component
+    Path border;
+    border.setUsingNonZeroWinding(false);
+    border.addRectangle(getLocalBounds());
+    border.addRoundedRectangle(getLocalBounds().toFloat().reduced(1), 4);
+    // Fill the border path with the background color
+    g.setColour(BACKGROUND_COLOR);
+    g.fillPath(border);
+}
+
+void DistributionHistogram::mouseDown(const juce::MouseEvent& e)
+{
+    if (e.mods.isPopupMenu())
+    {
+        showOptionsMenu();
+        return;
     }
+
+    // Clear the distribution when the chart is clicked
+    distribution.reset();
+}
+
+void DistributionHistogram::update()
+{
+    // The distribution keeps counting on the audio thread, so a hidden chart needs no copy
+    if (!isVisible())
+        return;
+
+    // Copy the counts so painting works on a consistent set of bins, and only repaint when
+    // they changed, which they do not while the transport is stopped
+    LevelDistribution::Counts newCounts;
+    distribution.getCounts(newCounts);
+    if (newCounts == counts)
+        return;
+
+    counts = newCounts;
+    repaint();
+}
+
+void DistributionHistogram::visibilityChanged()
+{
+    update();
+}
+
+void DistributionHistogram::setShowPercentiles(bool shouldShow)
+{
+    showPercentiles = shouldShow;
+    repaint();
+}
+
+void DistributionHistogram::showOptionsMenu()
+{
+    const auto halfLife = distribution.getHalfLife();
+
+    juce::PopupMenu menu;
+    menu.addItem(1, "Show Percentiles", true, showPercentiles);
+    menu.addSeparator();
+    menu.addItem(2, "No Decay", true, halfLife <= 0.f);
+    menu.addItem(3, "Decay 10s", true, halfLife == 10.f);
+    menu.addItem(4, "Decay 60s", true, halfLife == 60.f);
+    menu.addSeparator();
+    menu.addItem(5, "Reset");
+
+    juce::Component::SafePointer<DistributionHistogram> safeThis(this);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this), [safeThis](int result)
+    {
+        if (safeThis == nullptr)
+            return;
+
+        switch (result)
+        {
+            case 1: safeThis->setShowPercentiles(!safeThis->showPercentiles); break;
+            case 2: safeThis->distribution.setHalfLife(0.f); break;
+            case 3: safeThis->distribution.setHalfLife(10.f); break;
+            case 4: safeThis->distribution.setHalfLife(60.f); break;
+            case 5: safeThis->distribution.reset(); break;
+            default: break;
+        }
+    });
 }
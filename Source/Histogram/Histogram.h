@@ -3,76 +3,143 @@
 
 #include <JuceHeader.h>
 #include "../Constants.h"
+#include "../Rendering/PolylineRenderer.h"
+#include "../Profiling/PaintProfiler.h"
 
 using namespace juce;
 
 //==============================================================================
-// Circular buffer structure that allows reading all elements after writing
-template<typename T>
-struct ReadAllAfterWriteCircularBuffer
+// Summary of a stretch of level history: the lowest, highest and mean value in decibels
+struct HistoryBin
 {
-    using DataType = std::vector<T>; // Define the data type as a vector of type T
+    // Combines two consecutive bins into one covering both
+    static HistoryBin combine(const HistoryBin& a, const HistoryBin& b);
 
-    // Constructor initializes the circular buffer with a specified fill value
-    ReadAllAfterWriteCircularBuffer(T fillValue)
-    {
-        resize(1, fillValue); // Initialize with a single element and fill value
-    }
+    float min = NEGATIVE_INFINITY; // Lowest value in the stretch
+    float max = NEGATIVE_INFINITY; // Highest value in the stretch
+    float mean = NEGATIVE_INFINITY; // Mean value of the stretch
+};
 
-    // Resize the circular buffer and initialize with the fill value
-    void resize(std::size_t s, T fillValue)
-    {
-        data.resize(s); // Resize the data vector
-        clear(fillValue); // Clear the data with the fill value
-    }
+//==============================================================================
+// Multi-resolution level history. Level 0 holds one bin per update, and every higher
+// level halves the resolution of the one below it, so any span from seconds to hours
+// can be read back at one bin per pixel. All levels have the same fixed capacity,
+// which bounds the memory regardless of how long the history runs.
+struct LevelHistory
+{
+    static constexpr int numLevels = 16; // Level 15 holds one bin per 2^15 updates
+    static constexpr int levelCapacity = 2048; // Number of bins kept in each level
 
-    // Clear the circular buffer with the fill value
-    void clear(T fillValue)
-    {
-        data.assign(getSize(), fillValue); // Assign fill value to all elements
-        resetWriteIndex(); // Reset the write index to the beginning
-    }
+    LevelHistory();
 
-    // Write a new element to the circular buffer
-    void write(T t)
-    {
-        auto indexCopy = writeIndex.load(); // Load the current write index
-        data[indexCopy] = t; // Write the element at the current index
-        ++indexCopy; // Increment the index
-        if (indexCopy == getSize()) // If index exceeds buffer size, wrap around
-        {
-            indexCopy = 0;
-        }
-        writeIndex.store(indexCopy); // Store the updated write index
-    }
-
-    // Get a reference to the underlying data vector
-    DataType& getData()
-    {
-        return data;
-    }
+    // Removes all bins from every level
+    void clear();
 
-    // Get the read index (same as write index)
-    size_t getReadIndex() const
-    {
-        return writeIndex.load();
-    }
+    // Adds a new value to level 0 and carries completed pairs upwards. Returns the
+    // number of levels that received a new bin, so level n was updated if n < result.
+    int push(float value);
 
-    // Get the size of the circular buffer
-    size_t getSize() const
-    {
-        return data.size();
-    }
+    // Fills out with the most recent numBins bins of the given level, oldest first.
+    // Bins that are older than the stored history are left empty.
+    void read(int level, int numBins, std::vector<HistoryBin>& out) const;
+
+    // Returns the most recent bin of the given level
+    HistoryBin getLatest(int level) const;
 
 private:
-    // Reset the write index to the beginning
-    void resetWriteIndex()
+    // Ring of bins at one resolution
+    struct Level
     {
-        writeIndex.store(0);
-    }
+        std::vector<HistoryBin> bins; // Ring storage
+        int writeIndex = 0; // Index that receives the next bin
+        int numBins = 0; // Number of valid bins, saturating at levelCapacity
+        HistoryBin pending; // First bin of a pair waiting to be carried upwards
+        bool hasPending = false; // Flag indicating whether pending holds a bin
+    };
+
+    std::array<Level, numLevels> levels; // Levels from the finest to the coarsest resolution
+};
+
+//==============================================================================
+// Distribution of signal levels in fixed-width dB bins. The audio thread is the
+// only writer and adds the duration of each block to the bin of its level, so the
+// GUI can read the bins with relaxed atomics at any time.
+struct LevelDistribution
+{
+    static constexpr float binWidthDb = 0.5f; // Width of a bin in dB
+    static constexpr int numBins = static_cast<int>((MAX_DECIBELS - NEGATIVE_INFINITY) / binWidthDb); // -120 dB to +12 dB
+
+    using Counts = std::array<juce::uint64, numBins>;
+
+    LevelDistribution();
+
+    // Prepares the decay step for the given sample rate
+    void prepare(double sampleRate);
+
+    // Adds a block of numSamples samples at the given level, called from processBlock
+    void add(float levelDb, int numSamples);
+
+    // Requests the distribution to be cleared on the next processed block
+    void reset() { resetRequested.store(true); }
+
+    // Sets the half-life of the counts in seconds, 0 to accumulate without decay
+    void setHalfLife(float seconds) { halfLifeSeconds.store(seconds); }
+
+    // Returns the half-life of the counts in seconds
+    float getHalfLife() const { return halfLifeSeconds.load(); }
 
-    std::atomic<std::size_t> writeIndex {0}; // Atomic variable for the write index
-    DataType data; // Data vector for storing elements
+    // Copies the current counts into the given array
+    void getCounts(Counts& destination) const;
+
+    // Returns the centre of a bin in dB
+    static float getBinLevel(int index) { return NEGATIVE_INFINITY + (static_cast<float>(index) + 0.5f) * binWidthDb; }
+
+    // Returns the level below which the given proportion (0 - 1) of the counted time lies
+    static float getPercentile(const Counts& counts, float proportion);
+
+private:
+    // Multiplies every bin by the decay factor of one decay step
+    void applyDecay();
+
+    std::array<std::atomic<juce::uint64>, numBins> bins; // Number of samples counted in each bin
+    std::atomic<bool> resetRequested { false }; // Set by the GUI to clear the distribution
+    std::atomic<float> halfLifeSeconds { 0.f }; // Half-life of the counts, 0 for no decay
+    int decayStepLength = 4800; // Number of samples between decay steps
+    int samplesSinceDecay = 0; // Number of samples added since the last decay step
+};
+
+//==============================================================================
+// Bar chart of a LevelDistribution with optional percentile markers.
+// Left click resets the distribution, right click opens the options menu.
+struct DistributionHistogram : juce::Component
+{
+    // Constructor with the distribution to display and a title
+    DistributionHistogram(LevelDistribution& distributionInput, const juce::String& titleInput);
+
+    // Function to paint the bar chart
+    void paint(juce::Graphics& g) override;
+
+    // Function to handle mouse down events on the bar chart
+    void mouseDown(const juce::MouseEvent& e) override;
+
+    // Function to update the bar chart with the latest counts, skipped while hidden
+    void update();
+
+    // Function to catch up with the counts when the bar chart is shown again
+    void visibilityChanged() override;
+
+    // Shows or hides the percentile markers
+    void setShowPercentiles(bool shouldShow);
+
+private:
+    // Opens the menu with the percentile and decay options
+    void showOptionsMenu();
+
+    LevelDistribution& distribution; // Distribution to display
+    LevelDistribution::Counts counts {}; // Copy of the counts used for painting
+    bool showPercentiles = true; // Flag indicating whether to draw the percentile markers
+    const juce::String title; // Title of the bar chart
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
 
 //==============================================================================
@@ -91,54 +158,45 @@ struct Histogram : juce::Component
     // Function to handle mouse down events on the histogram
     void mouseDown(const juce::MouseEvent& e) override;
 
-    // Function to update the histogram with a new value
+    // Function to zoom the time span in or out with the mouse wheel
+    void mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+    // Function to update the histogram with a new value. The history always records it,
+    // but the image is only drawn while the histogram is visible.
     void update(float value);
 
-private:
-    // Function to display the path on the graphics context within the specified bounds
-    void displayPath(juce::Graphics& g, juce::Rectangle<float> bounds);
+    // Function to redraw the image when the histogram is shown after values arrived hidden
+    void visibilityChanged() override;
 
-    // Function to build the path using the circular buffer data and bounds
-    static juce::Path buildPath(juce::Path& p,
-        ReadAllAfterWriteCircularBuffer<float>& buffer,
-        juce::Rectangle<float> bounds)
-    {
-        p.clear(); // Clear the path
-        auto bufferSizeCopy = buffer.getSize(); // Get a copy of buffer size
-        auto bottomOfBoundsCopy = bounds.getBottom(); // Get the bottom of the bounds
-        auto& bufferDataCopy = buffer.getData(); // Get a reference to buffer data
-        int readIndexCopy = static_cast<int>(buffer.getReadIndex()); // Get the read index
-
-        // Lambda function to map decibel values to y-coordinates within the bounds
-        auto map = [bottomOfBoundsCopy](float db) { return juce::jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, bottomOfBoundsCopy, 0.f); };
-        // Lambda function to increment index with wrap-around behavior
-        auto increment = [bufferSizeCopy](int& index) mutable { index = (index + 1) % bufferSizeCopy; };
-
-        // Start the path at the initial point
-        p.startNewSubPath(0, map(bufferDataCopy[readIndexCopy]));
-        increment(readIndexCopy); // Increment the read index
-
-        // Build the path by iterating over the width of the bounds
-        for (int i = 1; i < bounds.getWidth(); ++i)
-        {
-            p.lineTo(i, map(bufferDataCopy[readIndexCopy])); // Add a line segment to the path
-            increment(readIndexCopy); // Increment the read index
-        }
-
-        juce::Path fillPath = p; // Create a copy of the path for filling
-        if (p.getBounds().getHeight() > 0) // If path height is positive
-        {
-            // Complete the fill path by closing the subpath
-            fillPath.lineTo(bounds.getRight(), bottomOfBoundsCopy);
-            fillPath.lineTo(bounds.getX(), bottomOfBoundsCopy);
-            fillPath.closeSubPath();
-            return fillPath; // Return the filled path
-        }
-        return {}; // Return an empty path if height is not positive
-    }
-
-    // Circular buffer to store decibel values
-    ReadAllAfterWriteCircularBuffer<float> buffer {float(NEGATIVE_INFINITY)};
-    juce::Path path; // Path to display the waveform
+    static constexpr float updateRate = 60.f; // Rate at which update is called, in Hz
+
+private:
+    // Maps a decibel value to a y-coordinate within the history image
+    int mapToY(float db) const;
+
+    // Maps a decibel value to a fractional y-position within the history image
+    float mapToPosition(float db) const;
+
+    // Draws a single column of the history image for the given bin
+    void drawColumn(int x, const HistoryBin& bin);
+
+    // Redraws the whole history image from the history at the current zoom level
+    void rebuildImage();
+
+    LevelHistory history; // Multi-resolution store of the decibel values
+    std::vector<HistoryBin> visibleBins; // Scratch space for rebuilding the image
+    int zoomLevel = 0; // History level shown, each level doubles the time span
+    // Persistent ring image of the history, one column per bin. Only the newest column is
+    // drawn on update, and paint blits the image in two parts starting at the write position.
+    juce::Image historyImage;
+    std::vector<juce::PixelARGB> gradientRows; // Premultiplied fill gradient, one colour per row
+    int writeX = 0; // Column of the history image that receives the next bin
+    bool imageIsStale = false; // Flag indicating that bins were added while the histogram was hidden
+
+    // Rows of the newest column and the number of consecutive columns drawn with the same rows.
+    // Once every visible column is the same, scrolling changes no pixels and repainting stops.
+    std::array<int, 3> latestRows {};
+    int identicalColumns = 0;
     const juce::String title; // Title of the histogram
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
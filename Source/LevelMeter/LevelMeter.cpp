@@ -6,6 +6,8 @@
 // Implementation for the Meter class
 void Meter::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Meters);
+
 
     // Fill this rectangle with a different color than the color filling the component
     g.setColour(BASE_COLOR);
@@ -13,15 +15,11 @@ void Meter::paint(juce::Graphics& g)
     g.fillRect(getLocalBounds().removeFromTop(5));
     g.setColour(HIGHLIGHT_COLOR);
 
-    // Maps peakDb to be between NEGATIVE_INFINITY and MAX_DECIBELS
-    // NEGATIVE_INFINITY corresponds to the BOTTOM of the component
-    // MAX_DECIBELS corresponds to the TOP of the component
+    // Maps peakDb to be between rangeMinDb and rangeMaxDb (NEGATIVE_INFINITY and MAX_DECIBELS by default)
+    // rangeMinDb corresponds to the BOTTOM of the component
+    // rangeMaxDb corresponds to the TOP of the component
     // y = 0.f is at the TOP of the component, and vice versa
-    float peakDbMapping = juce::jmap(peakDb, // sourceValue
-        NEGATIVE_INFINITY, // sourceRangeMin
-        MAX_DECIBELS, // sourceRangeMax
-        static_cast<float>(getHeight()), // targetRangeMin
-        0.f); // targetRangeMax
+    float peakDbMapping = mapToY(peakDb);
 
     // Draws the rectangle
     g.fillRoundedRectangle(0.f, // x
@@ -29,27 +27,14 @@ void Meter::paint(juce::Graphics& g)
         static_cast<float>(getWidth()), // width
         static_cast<float>(getHeight()) - peakDbMapping, 2); // height
 
-    float decayValueMapping = juce::jmap(decayingValueHolder.getCurrentValue(), // sourceValue
-        NEGATIVE_INFINITY, // sourceRangeMin
-        MAX_DECIBELS, // sourceRangeMax
-        static_cast<float>(getHeight()), // targetRangeMin
-        0.f); // targetRangeMax
-
-    juce::Colour color = decayingValueHolder.isOverThreshold() ?
+    // The tick shows the value captured by update, so a partial repaint never mixes two positions
+    juce::Colour color = tickOverThreshold ?
         juce::Colours::red : juce::Colours::grey;
     g.setColour(color);
 
     auto r = getLocalBounds().toFloat();
     r.setHeight(5.f);
-
-    if (decayingValueHolder.getHoldTime() != 0)
-    {
-        r.setY(decayValueMapping);
-    }
-    else
-    {
-        r.setY(peakDbMapping);
-    }
+    r.setY(mapToY(tickDb));
 
     if (show_tick)
         g.fillRect(r);
@@ -58,19 +43,61 @@ void Meter::paint(juce::Graphics& g)
 
 void Meter::update(float dbLevel, float decay_rate, float hold_time_, bool reset_hold, bool show_tick_)
 {
-    // Pass in a decibel value and store it in peakDb
-    peakDb = dbLevel;
-    show_tick = show_tick_;
-
     // Here the setLevelMeterDecay and setHoldTime will actually set the decay_rate and holdTime variable to the meter
     decayingValueHolder.updateHeldValue(dbLevel);
     // Because the decay rate could change anytime so we will pass the decay rate as argument from meter update function
     decayingValueHolder.setLevelMeterDecay(decay_rate);
     decayingValueHolder.setHoldTime(hold_time_);
 
-    // Call repaint()
     if (reset_hold)
         decayingValueHolder.setCurrentValue(NEGATIVE_INFINITY);
+
+    // Returns the rows between two y-coordinates, grown by the given margin
+    auto rowsBetween = [this](float y1, float y2, float margin)
+    {
+        return juce::Rectangle<float>(0.f, juce::jmin(y1, y2) - margin, static_cast<float>(getWidth()), std::abs(y1 - y2) + 2.f * margin)
+            .getSmallestIntegerContainer();
+    };
+
+    // The bar only changes between its old and new top edge, plus the rounded corners
+    const float oldBarY = mapToY(peakDb);
+    const float newBarY = mapToY(dbLevel);
+    if (std::abs(newBarY - oldBarY) >= 1.f)
+    {
+        repaint(rowsBetween(oldBarY, newBarY, 2.f));
+        peakDb = dbLevel;
+    }
+
+    // The tick follows the held value, or the bar when nothing is held
+    const float newTickDb = decayingValueHolder.getHoldTime() != 0 ? decayingValueHolder.getCurrentValue() : peakDb;
+    const bool newTickOverThreshold = decayingValueHolder.isOverThreshold();
+    const float oldTickY = mapToY(tickDb);
+    const float newTickY = mapToY(newTickDb);
+
+    if (show_tick_ != show_tick || newTickOverThreshold != tickOverThreshold || std::abs(newTickY - oldTickY) >= 1.f)
+    {
+        repaint(rowsBetween(oldTickY, oldTickY + 5.f, 1.f));
+        repaint(rowsBetween(newTickY, newTickY + 5.f, 1.f));
+        tickDb = newTickDb;
+        tickOverThreshold = newTickOverThreshold;
+        show_tick = show_tick_;
+    }
+}
+
+float Meter::mapToY(float db) const
+{
+    return juce::jmap(juce::jlimit(rangeMinDb, rangeMaxDb, db), // sourceValue
+        rangeMinDb, // sourceRangeMin
+        rangeMaxDb, // sourceRangeMax
+        static_cast<float>(getHeight()), // targetRangeMin
+        0.f); // targetRangeMax
+}
+
+void Meter::setRange(float minDb, float maxDb)
+{
+    // Store the range used to map dB values to the height of the meter
+    rangeMinDb = minDb;
+    rangeMaxDb = maxDb;
     repaint();
 }
 
@@ -78,37 +105,63 @@ void Meter::update(float dbLevel, float decay_rate, float hold_time_, bool reset
 // Implementation for the DbScale class
 void DbScale::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Meters);
+
+    // Render again only when the window moved to a display with a different pixel density
+    const float scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (scaleFactor != imageScale)
+        renderBackgroundImage(scaleFactor);
+
     g.drawImage(bkgd, getLocalBounds().toFloat());
 }
 
 void DbScale::buildBackgroundImage(int dbDivision, juce::Rectangle<int> meterBounds, int minDb, int maxDb)
 {
-    if (minDb < maxDb)
+    if (minDb > maxDb)
     {
         std::swap(minDb, maxDb);
     }
 
-    juce::Rectangle<int> bounds = getLocalBounds();
+    // Nothing to do when the layout is the one already rendered
+    if (bkgd.isValid() && dbDivision == division && meterBounds == tickBounds
+        && minDb == rangeMinDb && maxDb == rangeMaxDb && getLocalBounds() == imageBounds)
+    {
+        return;
+    }
+
+    division = dbDivision;
+    tickBounds = meterBounds;
+    rangeMinDb = minDb;
+    rangeMaxDb = maxDb;
+
+    renderBackgroundImage(imageScale > 0.f ? imageScale : juce::Desktop::getInstance().getGlobalScaleFactor());
+}
 
-    if (bounds.isEmpty())
+void DbScale::renderBackgroundImage(float scaleFactor)
+{
+    imageBounds = getLocalBounds();
+    imageScale = scaleFactor;
+
+    if (imageBounds.isEmpty())
     {
+        bkgd = {};
         return;
     }
 
-    float scaleFactor = juce::Desktop::getInstance().getGlobalScaleFactor();
+    // The image has one pixel per physical pixel, and is drawn back into the local bounds
     bkgd = juce::Image(juce::Image::ARGB, // format
-        static_cast<int>(bounds.getWidth()), // imageWidth
-        static_cast<int>(bounds.getHeight()), // imageHeight
+        juce::roundToInt(imageBounds.getWidth() * scaleFactor), // imageWidth
+        juce::roundToInt(imageBounds.getHeight() * scaleFactor), // imageHeight
         true); // clearImage
 
     // Create a Graphics context for bkgd
     juce::Graphics context(bkgd);
 
+    // Add a transform to it that accounts for the pixel scale factor
     context.addTransform(juce::AffineTransform().scaled(scaleFactor));
-    // Add a transform to it that accounts for the global scale factor
 
     context.setColour(juce::Colours::darkgrey);
-    auto ticks = getTicks(dbDivision, meterBounds, minDb, maxDb);
+    auto ticks = getTicks(division, tickBounds, rangeMinDb, rangeMaxDb);
 
     for (auto tick : ticks)
     {
@@ -279,12 +332,13 @@ void MacroMeter::update(float level, float decay_rate, bool show_peak, bool show
     // Add the current level to the averager
     averager.add(level);
 
-    // Update the show_peak_ and show_avg_ flags
-    show_peak_ = show_peak;
-    show_avg_ = show_avg;
-
-    // Resize the components
-    resized();
+    // The layout only changes with the meter view, not with the levels
+    if (show_peak != show_peak_ || show_avg != show_avg_)
+    {
+        show_peak_ = show_peak;
+        show_avg_ = show_avg;
+        resized();
+    }
 }
 
 //==============================================================================
@@ -300,6 +354,8 @@ StereoMeter::StereoMeter(juce::String nameInput) : labelText(nameInput)
 
 void StereoMeter::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Meters);
+
     // Draw the labels for left and right channels
     g.setColour(juce::Colours::darkgrey);
     g.drawText("    L", labelTextArea, juce::Justification::centredLeft);
@@ -340,9 +396,7 @@ void StereoMeter::update(float leftChanDb, float rightChanDb, float decay_rate,
     leftMeter.update(leftChanDb, decay_rate, show_peak, show_avg, hold_time_, reset_hold, show_tick);
     rightMeter.update(rightChanDb, decay_rate, show_peak, show_avg, hold_time_, reset_hold, show_tick);
 
-    // Resize the components and repaint
-    resized();
-    repaint();
+    // The labels and the scale are static; the meters repaint themselves
 }
 
 void StereoMeter::setText(juce::String labelName)
@@ -362,45 +416,55 @@ TextMeter::TextMeter()
 
 void TextMeter::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Meters);
+
     juce::Colour textColor;
-    float valueToDisplay;
+    float valueToDisplay = displayedValueDb;
 
-    // Determine the color and value to display based on whether the current value is over the threshold
-    if (valueHolder.getIsOverThreshold())
+    // Determine the color to display based on whether the shown value is over the threshold
+    if (displayedOverThreshold)
     {
-        // If over threshold, set color to red and display the held value
+        // If over threshold, set color to red, the value is the held value
         g.setColour(juce::Colours::red);
         g.fillRoundedRectangle(getLocalBounds().toFloat(), 4);
         g.fillRect(getLocalBounds().removeFromBottom(5));
         textColor = juce::Colours::black;
-        valueToDisplay = valueHolder.getHeldValue();
     }
     else
     {
-        // If not over threshold, set color to base color and display the current value
+        // If not over threshold, set color to base color, the value is the current value
         g.setColour(BASE_COLOR);
         g.fillRoundedRectangle(getLocalBounds().toFloat(), 4);
         g.fillRect(getLocalBounds().removeFromBottom(5));
         textColor = HIGHLIGHT_COLOR;
-        valueToDisplay = valueHolder.getCurrentValue();
     }
     g.setColour(textColor);
-    g.setFont(12.f);
 
-    // Draw the text with appropriate formatting
-    g.drawFittedText(valueToDisplay > NEGATIVE_INFINITY ?
-        juce::String(valueToDisplay, 1).trimEnd() : "-inf", // text
-        getLocalBounds(), // bounds
-        juce::Justification::centredBottom, // justification
-        1); // number of lines
+    // Blit the pre-rendered value instead of laying out the text on every paint
+    glyphCache->draw(g, valueToDisplay, font, getLocalBounds(), juce::Justification::centredBottom);
 }
 
 void TextMeter::update(float valueDb)
 {
-    // Update the cached value, held value, and repaint
+    // Update the cached value and held value
     cachedValueDb = valueDb;
     valueHolder.updateHeldValue(valueDb);
-    repaint();
+
+    const bool overThreshold = valueHolder.getIsOverThreshold();
+    const float valueToDisplay = overThreshold ? valueHolder.getHeldValue() : valueHolder.getCurrentValue();
+
+    // The text has a resolution of 0.1 dB, smaller changes would paint the same pixels
+    if (overThreshold != displayedOverThreshold || toTenths(valueToDisplay) != toTenths(displayedValueDb))
+    {
+        displayedValueDb = valueToDisplay;
+        displayedOverThreshold = overThreshold;
+        repaint();
+    }
+}
+
+int TextMeter::toTenths(float valueDb)
+{
+    return valueDb > NEGATIVE_INFINITY ? juce::roundToInt(valueDb * 10.f) : std::numeric_limits<int>::min();
 }
 
 //==============================================================================
@@ -4,6 +4,8 @@
 #include <JuceHeader.h>
 #include "../GonioMeter/Goniometer.h"
 #include "../Constants.h"
+#include "../Profiling/PaintProfiler.h"
+#include "../Rendering/NumericGlyphCache.h"
 
 
 struct Tick
@@ -19,15 +21,27 @@ struct DbScale : juce::Component
 
     void paint(juce::Graphics& g) override;
 
-    // Builds the background image for the dB scale
+    // Sets the layout of the dB scale. The background image is only rebuilt when the
+    // layout or the size of the component changed since it was last rendered.
     void buildBackgroundImage(int dbDivision, juce::Rectangle<int> meterBounds, int minDb, int maxDb);
 
     // Returns a vector of ticks for the dB scale
     static std::vector<Tick> getTicks(int dbDivision, juce::Rectangle<int> meterBounds, int minDb, int maxDb);
 
 private:
-    juce::Image bkgd; // Background image for the dB scale
+    // Renders the tick labels into the background image at the given pixel scale factor
+    void renderBackgroundImage(float scaleFactor);
+
+    juce::Image bkgd; // Background image for the dB scale, rendered at physical pixel resolution
     bool show_tick = true; // Flag indicating whether to display ticks on the scale
+
+    // Layout the background image was rendered for
+    int division = 10; // dB between ticks
+    int rangeMinDb = 0, rangeMaxDb = 0; // dB values at the bottom and the top of the meter
+    juce::Rectangle<int> tickBounds; // Area the ticks are spread over
+    juce::Rectangle<int> imageBounds; // Bounds of the component
+    float imageScale = 0.f; // Physical pixel scale factor
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
 
 //==============================================================================
@@ -73,12 +87,20 @@ struct TextMeter : juce::Component
     // Paints the component
     void paint(juce::Graphics& g) override;
 
-    // Updates the displayed dB value
+    // Updates the displayed dB value, repainting only when the text or its colour changes
     void update(float valueDb);
 
 private:
+    // Returns a value in tenths of a dB as shown by the text, with a sentinel for -inf
+    static int toTenths(float valueDb);
+
     float cachedValueDb; // Cached dB value
+    float displayedValueDb { NEGATIVE_INFINITY }; // Value currently shown
+    bool displayedOverThreshold { false }; // Whether the shown value is highlighted
     ValueHolder valueHolder; // Value holder for managing the displayed value
+    juce::SharedResourcePointer<NumericGlyphCache> glyphCache; // Pre-rendered value strings shared by the readouts
+    const juce::Font font { 12.f }; // Font of the value
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
 
 
@@ -131,13 +153,26 @@ struct Meter : juce::Component
     // Paints the component
     void paint(juce::Graphics&) override;
 
-    // Updates the meter with the specified dB level, decay rate, hold time, reset flag, and show tick flag
+    // Updates the meter with the specified dB level, decay rate, hold time, reset flag, and show tick flag.
+    // Only the rows between the old and new bar and tick positions are repainted, and nothing
+    // is repainted when they moved by less than a pixel.
     void update(float dbLevel, float decay_rate, float hold_time_, bool reset_hold, bool show_tick_);
 
+    // Sets the dB values mapped to the bottom and the top of the meter
+    void setRange(float minDb, float maxDb);
+
 private:
-    float peakDb { NEGATIVE_INFINITY }; // Peak dB level
+    // Maps a dB value to a y-coordinate, rangeMaxDb at the top and rangeMinDb at the bottom
+    float mapToY(float db) const;
+
+    float peakDb { NEGATIVE_INFINITY }; // Peak dB level currently shown
+    float tickDb { NEGATIVE_INFINITY }; // Tick dB level currently shown
+    bool tickOverThreshold = false; // Whether the tick is currently shown in red
+    float rangeMinDb { NEGATIVE_INFINITY }; // dB value at the bottom of the meter
+    float rangeMaxDb { MAX_DECIBELS }; // dB value at the top of the meter
     bool show_tick = false; // Flag indicating whether to show the tick
     DecayingValueHolder decayingValueHolder; // Decaying value holder for managing the meter value
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
 
 //==============================================================================
@@ -185,4 +220,5 @@ private:
     MacroMeter leftMeter, rightMeter; // Left and right macro meter components
     DbScale dbScale; // dB scale component
     juce::Label label; // Label component
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };
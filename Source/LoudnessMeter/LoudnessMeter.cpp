@@ -0,0 +1,370 @@
+#include "LoudnessMeter.h"
+
+//==============================================================================
+// Implementation for the LoudnessHistogram class
+LoudnessHistogram::LoudnessHistogram()
+{
+    // Pre-compute the energy represented by each bin so queries only need multiply-adds
+    for (int i = 0; i < numBins; ++i)
+    {
+        binEnergies[i] = std::pow(10.0, (getBinLoudness(i) + 0.691) / 10.0);
+    }
+
+    clear();
+}
+
+void LoudnessHistogram::clear()
+{
+    counts.fill(0);
+    numEntries = 0;
+}
+
+void LoudnessHistogram::add(float loudness)
+{
+    // Blocks below the absolute gate never contribute to a measurement
+    if (loudness < minLoudness)
+        return;
+
+    ++counts[getBinIndex(loudness)];
+    ++numEntries;
+}
+
+double LoudnessHistogram::getGatedMeanEnergy(float gateLoudness) const
+{
+    double energySum = 0.0;
+    juce::uint64 count = 0;
+
+    for (int i = getBinIndex(gateLoudness); i < numBins; ++i)
+    {
+        energySum += counts[i] * binEnergies[i];
+        count += counts[i];
+    }
+
+    return count > 0 ? energySum / static_cast<double>(count) : 0.0;
+}
+
+float LoudnessHistogram::getPercentile(float gateLoudness, float proportion) const
+{
+    const int firstBin = getBinIndex(gateLoudness);
+
+    // Count the entries above the gate
+    juce::uint64 count = 0;
+    for (int i = firstBin; i < numBins; ++i)
+    {
+        count += counts[i];
+    }
+
+    if (count == 0)
+        return NEGATIVE_INFINITY;
+
+    // Walk the cumulative counts until the requested proportion is reached
+    const auto target = static_cast<juce::uint64>(proportion * static_cast<float>(count - 1));
+    juce::uint64 cumulative = 0;
+    for (int i = firstBin; i < numBins; ++i)
+    {
+        cumulative += counts[i];
+        if (cumulative > target)
+            return getBinLoudness(i);
+    }
+
+    return getBinLoudness(numBins - 1);
+}
+
+int LoudnessHistogram::getBinIndex(float loudness)
+{
+    auto index = static_cast<int>((loudness - minLoudness) / resolution);
+    return juce::jlimit(0, numBins - 1, index);
+}
+
+float LoudnessHistogram::getBinLoudness(int index)
+{
+    return minLoudness + (static_cast<float>(index) + 0.5f) * resolution;
+}
+
+//==============================================================================
+// Implementation for the LoudnessAnalyzer class
+LoudnessAnalyzer::LoudnessAnalyzer()
+{
+    subBlockEnergies.fill(0.0);
+}
+
+void LoudnessAnalyzer::prepare(double sampleRate, int numChannels)
+{
+    juce::ignoreUnused(numChannels);
+
+    // Stage 1: high shelf modelling the acoustic effect of the head (BS.1770-4, table 1)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        BiquadCoefficients coefficients;
+        coefficients.b0 = (vh + vb * k / q + k * k) / a0;
+        coefficients.b1 = 2.0 * (k * k - vh) / a0;
+        coefficients.b2 = (vh - vb * k / q + k * k) / a0;
+        coefficients.a1 = 2.0 * (k * k - 1.0) / a0;
+        coefficients.a2 = (1.0 - k / q + k * k) / a0;
+
+        kWeighting.setCoefficients(0, coefficients);
+    }
+
+    // Stage 2: revised low-frequency B-curve high pass (BS.1770-4, table 2)
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        BiquadCoefficients coefficients;
+        coefficients.b0 = 1.0;
+        coefficients.b1 = -2.0;
+        coefficients.b2 = 1.0;
+        coefficients.a1 = 2.0 * (k * k - 1.0) / a0;
+        coefficients.a2 = (1.0 - k / q + k * k) / a0;
+
+        kWeighting.setCoefficients(1, coefficients);
+    }
+
+    // Gating blocks overlap by 75%, so the loudness is updated every 100 ms
+    subBlockLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    clear();
+}
+
+void LoudnessAnalyzer::process(const juce::AudioBuffer<float>& buffer)
+{
+    if (resetRequested.exchange(false))
+        clear();
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), maxChannels);
+    const int numSamples = buffer.getNumSamples();
+    int position = 0;
+
+    while (position < numSamples)
+    {
+        // Process up to the end of the current sub-block
+        const int count = juce::jmin(numSamples - position, subBlockLength - subBlockSampleCount);
+
+        // Both channels are weighted together, a missing channel is fed silence
+        std::array<const float*, maxChannels> channelData {};
+        for (int channel = 0; channel < numChannels; ++channel)
+            channelData[channel] = buffer.getReadPointer(channel, position);
+
+        std::array<double, maxChannels> sums {};
+        for (int i = 0; i < count; ++i)
+        {
+            decltype(kWeighting)::Frame weighted;
+            for (int channel = 0; channel < maxChannels; ++channel)
+                weighted[channel] = channelData[channel] != nullptr ? channelData[channel][i] : 0.f;
+
+            kWeighting.process(weighted);
+
+            for (int channel = 0; channel < maxChannels; ++channel)
+                sums[channel] += weighted[channel] * weighted[channel];
+        }
+
+        for (auto sum : sums)
+            subBlockSum += sum;
+
+        subBlockSampleCount += count;
+        position += count;
+
+        if (subBlockSampleCount == subBlockLength)
+            finishSubBlock();
+    }
+}
+
+float LoudnessAnalyzer::energyToLoudness(double energy)
+{
+    if (energy <= 0.0)
+        return NEGATIVE_INFINITY;
+
+    return juce::jmax(NEGATIVE_INFINITY, static_cast<float>(-0.691 + 10.0 * std::log10(energy)));
+}
+
+void LoudnessAnalyzer::clear()
+{
+    kWeighting.reset();
+
+    subBlockEnergies.fill(0.0);
+    subBlockIndex = 0;
+    numSubBlocks = 0;
+    subBlockSampleCount = 0;
+    subBlockSum = 0.0;
+
+    integratedHistogram.clear();
+    rangeHistogram.clear();
+
+    momentaryLoudness.store(NEGATIVE_INFINITY);
+    shortTermLoudness.store(NEGATIVE_INFINITY);
+    integratedLoudness.store(NEGATIVE_INFINITY);
+    loudnessRange.store(0.f);
+}
+
+void LoudnessAnalyzer::finishSubBlock()
+{
+    // Store the mean square of the sub-block in the ring
+    subBlockEnergies[subBlockIndex] = subBlockSum / static_cast<double>(subBlockLength);
+    subBlockIndex = (subBlockIndex + 1) % shortTermBlocks;
+    numSubBlocks = juce::jmin(numSubBlocks + 1, shortTermBlocks);
+    subBlockSum = 0.0;
+    subBlockSampleCount = 0;
+
+    const auto momentary = energyToLoudness(getMeanEnergy(momentaryBlocks));
+    const auto shortTerm = energyToLoudness(getMeanEnergy(shortTermBlocks));
+    momentaryLoudness.store(momentary);
+    shortTermLoudness.store(shortTerm);
+
+    // Every complete 400 ms gating block contributes to the integrated loudness
+    if (numSubBlocks >= momentaryBlocks)
+        integratedHistogram.add(momentary);
+
+    // Every complete 3 s window contributes to the loudness range (EBU Tech 3342)
+    if (numSubBlocks >= shortTermBlocks)
+        rangeHistogram.add(shortTerm);
+
+    // Integrated loudness: absolute gate at -70 LUFS, relative gate 10 LU below the absolute-gated loudness
+    const auto absoluteGatedEnergy = integratedHistogram.getGatedMeanEnergy(LoudnessHistogram::minLoudness);
+    if (absoluteGatedEnergy > 0.0)
+    {
+        const auto relativeGate = energyToLoudness(absoluteGatedEnergy) - 10.f;
+        integratedLoudness.store(energyToLoudness(integratedHistogram.getGatedMeanEnergy(relativeGate)));
+    }
+
+    // Loudness range: relative gate 20 LU below, spread between the 10th and 95th percentiles
+    const auto rangeGatedEnergy = rangeHistogram.getGatedMeanEnergy(LoudnessHistogram::minLoudness);
+    if (rangeGatedEnergy > 0.0)
+    {
+        const auto relativeGate = energyToLoudness(rangeGatedEnergy) - 20.f;
+        const auto low = rangeHistogram.getPercentile(relativeGate, 0.10f);
+        const auto high = rangeHistogram.getPercentile(relativeGate, 0.95f);
+        loudnessRange.store(juce::jmax(0.f, high - low));
+    }
+}
+
+double LoudnessAnalyzer::getMeanEnergy(int numBlocks) const
+{
+    double sum = 0.0;
+    int index = subBlockIndex;
+
+    // Walk backwards from the most recent sub-block
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        index = (index + shortTermBlocks - 1) % shortTermBlocks;
+        sum += subBlockEnergies[index];
+    }
+
+    return sum / static_cast<double>(numBlocks);
+}
+
+//==============================================================================
+// Implementation for the LoudnessMeter class
+LoudnessMeter::LoudnessMeter(LoudnessAnalyzer& analyzerInput, juce::String nameInput) :
+    analyzer(analyzerInput),
+    labelText(nameInput)
+{
+    // The bars use the loudness scale instead of the full dB range
+    momentaryMeter.setRange(LOUDNESS_SCALE_MIN, LOUDNESS_SCALE_MAX);
+    shortTermMeter.setRange(LOUDNESS_SCALE_MIN, LOUDNESS_SCALE_MAX);
+
+    // Add and make visible the child components
+    addAndMakeVisible(momentaryText);
+    addAndMakeVisible(shortTermText);
+    addAndMakeVisible(momentaryMeter);
+    addAndMakeVisible(shortTermMeter);
+    addAndMakeVisible(dbScale);
+
+    // Clicks are handled by this component to reset the measurement
+    momentaryText.setInterceptsMouseClicks(false, false);
+    shortTermText.setInterceptsMouseClicks(false, false);
+    momentaryMeter.setInterceptsMouseClicks(false, false);
+    shortTermMeter.setInterceptsMouseClicks(false, false);
+    dbScale.setInterceptsMouseClicks(false, false);
+}
+
+void LoudnessMeter::paint(juce::Graphics& g)
+{
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Meters);
+
+    // Draw the labels for the momentary and short-term bars
+    g.setColour(juce::Colours::darkgrey);
+    g.drawText("    M", labelTextArea, juce::Justification::centredLeft);
+    g.drawText(labelText, labelTextArea, juce::Justification::centred);
+    g.drawText("S    ", labelTextArea, juce::Justification::centredRight);
+
+    // Draw the integrated loudness and loudness range readouts
+    auto readouts = readoutArea;
+    g.setColour(BASE_COLOR);
+    g.fillRoundedRectangle(readouts.toFloat(), 4);
+    g.setColour(HIGHLIGHT_COLOR);
+    g.setFont(readoutFont);
+
+    // The labels are drawn as text, the values are blitted from the glyph cache
+    auto integratedArea = readouts.removeFromTop(readouts.getHeight() / 2);
+    g.drawText("I", integratedArea.reduced(4, 0), juce::Justification::centredLeft);
+    glyphCache->draw(g, integratedLoudness, readoutFont, integratedArea.reduced(4, 0), juce::Justification::centredRight);
+
+    g.drawText("LRA", readouts.reduced(4, 0), juce::Justification::centredLeft);
+    glyphCache->draw(g, loudnessRange, readoutFont, readouts.reduced(4, 0), juce::Justification::centredRight);
+}
+
+void LoudnessMeter::resized()
+{
+    auto bounds = getLocalBounds();
+    auto meterWidth = bounds.getWidth() / 3;
+
+    // Set the bounds for the label and the readouts
+    labelTextArea = bounds.removeFromBottom(30);
+    readoutArea = bounds.removeFromBottom(30).withTrimmedTop(2);
+
+    // Set the bounds for the momentary column
+    auto momentaryArea = bounds.removeFromLeft(meterWidth);
+    momentaryText.setBounds(momentaryArea.removeFromTop(14));
+    momentaryMeter.setBounds(momentaryArea);
+
+    // Set the bounds for the short-term column
+    auto shortTermArea = bounds.removeFromRight(meterWidth);
+    shortTermText.setBounds(shortTermArea.removeFromTop(14));
+    shortTermMeter.setBounds(shortTermArea);
+
+    // Set the bounds for the dbScale component
+    dbScale.setBounds(bounds);
+    bounds = bounds.withTrimmedBottom(5);
+    dbScale.buildBackgroundImage(10, bounds.withTrimmedTop(13), LOUDNESS_SCALE_MIN, LOUDNESS_SCALE_MAX);
+}
+
+void LoudnessMeter::mouseDown(const juce::MouseEvent& e)
+{
+    // Restart the integrated and range measurements
+    analyzer.reset();
+}
+
+void LoudnessMeter::update(float decay_rate, bool show_tick, float hold_time_, bool reset_hold)
+{
+    auto momentary = analyzer.getMomentaryLoudness();
+    auto shortTerm = analyzer.getShortTermLoudness();
+
+    // Update the text meters and bars with the latest readings
+    momentaryText.update(momentary);
+    shortTermText.update(shortTerm);
+    momentaryMeter.update(momentary, decay_rate, hold_time_, reset_hold, show_tick);
+    shortTermMeter.update(shortTerm, decay_rate, hold_time_, reset_hold, show_tick);
+
+    // The readouts show tenths, so they are only repainted when a shown digit changes
+    auto toTenths = [](float value) { return juce::roundToInt(juce::jmax(value, NEGATIVE_INFINITY) * 10.f); };
+    const auto newIntegratedLoudness = analyzer.getIntegratedLoudness();
+    const auto newLoudnessRange = analyzer.getLoudnessRange();
+    const bool changed = toTenths(newIntegratedLoudness) != toTenths(integratedLoudness)
+                      || toTenths(newLoudnessRange) != toTenths(loudnessRange);
+
+    integratedLoudness = newIntegratedLoudness;
+    loudnessRange = newLoudnessRange;
+    if (changed)
+        repaint(readoutArea);
+}
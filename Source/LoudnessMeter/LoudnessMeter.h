@@ -0,0 +1,151 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../LevelMeter/LevelMeter.h"
+#include "../Constants.h"
+#include "../DSP/BiquadBank.h"
+
+// Two macros to set the bounds of the loudness scale in LUFS
+#define LOUDNESS_SCALE_MIN -60.f
+#define LOUDNESS_SCALE_MAX 0.f
+
+//==============================================================================
+// Fixed-resolution histogram of block loudness values used for gating.
+// Memory and the cost of a query do not depend on the programme length.
+struct LoudnessHistogram
+{
+    static constexpr float minLoudness = -70.f; // Lowest loudness that can be stored (absolute gate)
+    static constexpr float maxLoudness = 5.f; // Highest loudness that can be stored
+    static constexpr float resolution = 0.1f; // Width of a bin in LU
+    static constexpr int numBins = 750; // (maxLoudness - minLoudness) / resolution
+
+    LoudnessHistogram();
+
+    // Removes all entries from the histogram
+    void clear();
+
+    // Adds a block loudness value to the histogram; values below the absolute gate are ignored
+    void add(float loudness);
+
+    // Returns the mean energy of all entries at or above the gate, or 0 if there are none
+    double getGatedMeanEnergy(float gateLoudness) const;
+
+    // Returns the loudness below which the given proportion (0 - 1) of the gated entries lie
+    float getPercentile(float gateLoudness, float proportion) const;
+
+    // Returns the total number of entries in the histogram
+    juce::uint64 getNumEntries() const { return numEntries; }
+
+private:
+    // Returns the bin that holds the given loudness value
+    static int getBinIndex(float loudness);
+
+    // Returns the loudness at the centre of a bin
+    static float getBinLoudness(int index);
+
+    std::array<juce::uint32, numBins> counts; // Number of blocks that fell into each bin
+    std::array<double, numBins> binEnergies; // Mean square energy at the centre of each bin
+    juce::uint64 numEntries = 0; // Total number of blocks in the histogram
+};
+
+//==============================================================================
+// ITU-R BS.1770-4 / EBU R128 loudness measurement that runs on the audio thread.
+// The K-weighted signal power is integrated over 100 ms sub-blocks, from which the
+// momentary (400 ms) and short-term (3 s) loudness are derived. Integrated loudness
+// and loudness range are computed from gating histograms.
+struct LoudnessAnalyzer
+{
+    LoudnessAnalyzer();
+
+    // Prepares the K-weighting filters and block sizes for the given sample rate
+    void prepare(double sampleRate, int numChannels);
+
+    // Measures the loudness of the given buffer, called from processBlock
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Requests the measurement to be restarted on the next processed block
+    void reset() { resetRequested.store(true); }
+
+    // Returns the momentary loudness in LUFS
+    float getMomentaryLoudness() const { return momentaryLoudness.load(); }
+
+    // Returns the short-term loudness in LUFS
+    float getShortTermLoudness() const { return shortTermLoudness.load(); }
+
+    // Returns the integrated loudness in LUFS
+    float getIntegratedLoudness() const { return integratedLoudness.load(); }
+
+    // Returns the loudness range in LU
+    float getLoudnessRange() const { return loudnessRange.load(); }
+
+    // Converts a mean square energy to LUFS, using NEGATIVE_INFINITY for silence
+    static float energyToLoudness(double energy);
+
+private:
+    // Clears the filter states, sub-block history and histograms
+    void clear();
+
+    // Completes the current 100 ms sub-block and updates the published readings
+    void finishSubBlock();
+
+    // Returns the mean energy of the most recent sub-blocks
+    double getMeanEnergy(int numBlocks) const;
+
+    static constexpr int maxChannels = 2; // Left and right channels are weighted equally
+    static constexpr int momentaryBlocks = 4; // 400 ms of 100 ms sub-blocks
+    static constexpr int shortTermBlocks = 30; // 3 s of 100 ms sub-blocks
+
+    // K-weighting of both channels as lanes of one bank: the high shelf stage followed by the high pass (RLB) stage
+    BiquadBank<maxChannels, 2> kWeighting;
+
+    std::array<double, shortTermBlocks> subBlockEnergies; // Ring of the latest sub-block energies
+    int subBlockIndex = 0; // Write index into subBlockEnergies
+    int numSubBlocks = 0; // Number of sub-blocks measured, saturating at shortTermBlocks
+    int subBlockLength = 4800; // Number of samples in a sub-block
+    int subBlockSampleCount = 0; // Number of samples accumulated in the current sub-block
+    double subBlockSum = 0.0; // Sum of the squared K-weighted samples of the current sub-block
+
+    LoudnessHistogram integratedHistogram; // Momentary block loudness for the integrated measurement
+    LoudnessHistogram rangeHistogram; // Short-term loudness for the loudness range measurement
+
+    std::atomic<bool> resetRequested { false }; // Set by the GUI to restart the measurement
+    std::atomic<float> momentaryLoudness { NEGATIVE_INFINITY }; // Published momentary loudness
+    std::atomic<float> shortTermLoudness { NEGATIVE_INFINITY }; // Published short-term loudness
+    std::atomic<float> integratedLoudness { NEGATIVE_INFINITY }; // Published integrated loudness
+    std::atomic<float> loudnessRange { 0.f }; // Published loudness range
+};
+
+//==============================================================================
+// Column showing momentary and short-term loudness bars with the integrated
+// loudness and loudness range below them. Clicking the column resets the measurement.
+class LoudnessMeter : public juce::Component
+{
+public:
+    // Constructor with the analyzer to display and name input
+    LoudnessMeter(LoudnessAnalyzer& analyzerInput, juce::String nameInput);
+
+    // Paints the component
+    void paint(juce::Graphics& g) override;
+
+    // Called when the component is resized
+    void resized() override;
+
+    // Resets the measurement when the component is clicked
+    void mouseDown(const juce::MouseEvent& e) override;
+
+    // Updates the loudness meter with the latest readings of the analyzer, decay rate, show tick flag, hold time, and reset hold flag
+    void update(float decay_rate, bool show_tick, float hold_time_, bool reset_hold);
+
+private:
+    LoudnessAnalyzer& analyzer; // Analyzer providing the loudness readings
+    juce::Rectangle<int> labelTextArea, readoutArea; // Rectangles for the label and the integrated readouts
+    juce::String labelText; // Text label
+    TextMeter momentaryText, shortTermText; // Text meters above the bars
+    Meter momentaryMeter, shortTermMeter; // Momentary and short-term meter components
+    DbScale dbScale; // LUFS scale component
+    float integratedLoudness { NEGATIVE_INFINITY }; // Cached integrated loudness
+    float loudnessRange { 0.f }; // Cached loudness range
+    juce::SharedResourcePointer<NumericGlyphCache> glyphCache; // Pre-rendered readout values shared with the text meters
+    const juce::Font readoutFont { 12.f }; // Font of the readouts
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
+};
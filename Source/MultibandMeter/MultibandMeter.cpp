@@ -0,0 +1,210 @@
+#include "MultibandMeter.h"
+
+//==============================================================================
+// Implementation for the MultibandSnapshot class
+void MultibandSnapshot::merge(const MultibandSnapshot& other)
+{
+    if (other.numSamples == 0)
+        return;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        peaks[band] = juce::jmax(peaks[band], other.peaks[band]);
+        sumsOfSquares[band] += other.sumsOfSquares[band];
+    }
+
+    // The correlation is already smoothed, so the most recent reading is kept
+    correlations = other.correlations;
+    numSamples += other.numSamples;
+}
+
+float MultibandSnapshot::getRMS(int band) const
+{
+    // Both channels are summed into the same band, so the power is averaged over twice the samples
+    return numSamples > 0 ? static_cast<float>(std::sqrt(sumsOfSquares[band] / (2.0 * numSamples))) : 0.f;
+}
+
+//==============================================================================
+// Implementation for the MultibandAnalyzer class
+void MultibandAnalyzer::prepare(double sampleRate)
+{
+    if (sampleRate <= 0.0)
+        sampleRate = 44100.0;
+
+    // Each band is high passed at its lower edge and low passed at its upper edge.
+    // The outer bands only have one edge, their remaining sections pass the signal through.
+    for (int band = 0; band < numBands; ++band)
+    {
+        std::array<BiquadCoefficients, CrossoverBank::numStages> sections;
+        int section = 0;
+
+        if (band > 0)
+        {
+            sections[section++] = BiquadCoefficients::makeHighPass(sampleRate, crossoverFrequencies[band - 1]);
+            sections[section++] = BiquadCoefficients::makeHighPass(sampleRate, crossoverFrequencies[band - 1]);
+        }
+
+        if (band < numBands - 1)
+        {
+            sections[section++] = BiquadCoefficients::makeLowPass(sampleRate, crossoverFrequencies[band]);
+            sections[section++] = BiquadCoefficients::makeLowPass(sampleRate, crossoverFrequencies[band]);
+        }
+
+        for (int stage = 0; stage < CrossoverBank::numStages; ++stage)
+        {
+            crossover.setCoefficients(stage, band * 2, sections[stage]);
+            crossover.setCoefficients(stage, band * 2 + 1, sections[stage]);
+        }
+    }
+
+    integrators.setCoefficients(0, BiquadCoefficients::makeOnePole(correlationTimeConstantMs, sampleRate));
+    crossover.reset();
+    integrators.reset();
+
+    // One snapshot every 10 ms keeps the FIFO far from full at a 60 Hz frame rate
+    snapshotLength = static_cast<juce::uint32>(juce::jmax(1, juce::roundToInt(sampleRate * 0.01)));
+    pending = {};
+}
+
+void MultibandAnalyzer::process(const juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (buffer.getNumChannels() == 0 || numSamples == 0)
+        return;
+
+    // A mono input feeds both channels of every band
+    auto* left = buffer.getReadPointer(0);
+    auto* right = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
+
+    CrossoverBank::Frame peaks {}, squares {};
+    IntegratorBank::Frame products {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        CrossoverBank::Frame x;
+        for (int lane = 0; lane < CrossoverBank::numLanes; lane += 2)
+        {
+            x[lane] = left[i];
+            x[lane + 1] = right[i];
+        }
+
+        crossover.process(x);
+
+        for (int lane = 0; lane < CrossoverBank::numLanes; ++lane)
+        {
+            peaks[lane] = juce::jmax(peaks[lane], std::abs(x[lane]));
+            squares[lane] += x[lane] * x[lane];
+        }
+
+        for (int band = 0; band < numBands; ++band)
+        {
+            const float l = x[band * 2];
+            const float r = x[band * 2 + 1];
+            products[band] = l * r;
+            products[numBands + band] = l * l;
+            products[2 * numBands + band] = r * r;
+        }
+
+        integrators.process(products);
+    }
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        pending.peaks[band] = juce::jmax(pending.peaks[band], peaks[band * 2], peaks[band * 2 + 1]);
+        pending.sumsOfSquares[band] += static_cast<double>(squares[band * 2]) + squares[band * 2 + 1];
+
+        // Silence has no defined correlation and is shown as 0
+        const auto denominator = std::sqrt(products[numBands + band] * products[2 * numBands + band]);
+        pending.correlations[band] = denominator > 1.0e-9f ? juce::jlimit(-1.f, 1.f, products[band] / denominator) : 0.f;
+    }
+    pending.numSamples += static_cast<juce::uint32>(numSamples);
+
+    if (pending.numSamples >= snapshotLength)
+    {
+        snapshotFifo.push(pending);
+        pending = {};
+    }
+}
+
+//==============================================================================
+// Implementation for the MultibandMeter class
+MultibandMeter::MultibandMeter(MultibandAnalyzer& analyzerInput) : analyzer(analyzerInput) {}
+
+void MultibandMeter::paint(juce::Graphics& g)
+{
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Multiband);
+
+    static const juce::StringArray bandNames { "LO", "LM", "HM", "HI" };
+
+    // Fill the background with the base color
+    g.setColour(BASE_COLOR);
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 3);
+
+    auto bounds = getLocalBounds().reduced(4, 3);
+    const int rowHeight = bounds.getHeight() / MultibandSnapshot::numBands;
+
+    g.setFont(9.f);
+    for (int band = 0; band < MultibandSnapshot::numBands; ++band)
+    {
+        auto row = bounds.removeFromTop(rowHeight).reduced(0, 1);
+
+        g.setColour(juce::Colours::white);
+        g.drawText(bandNames[band], row.removeFromLeft(16), juce::Justification::centredLeft);
+
+        auto levelBounds = row.removeFromLeft(row.getWidth() / 2).withTrimmedRight(3).toFloat();
+        auto correlationBounds = row.toFloat();
+
+        // RMS bar with a peak line, mapped from NEGATIVE_INFINITY to MAX_DECIBELS
+        auto toX = [&levelBounds](float gain)
+        {
+            const auto db = juce::Decibels::gainToDecibels(gain, NEGATIVE_INFINITY);
+            return juce::jmap(juce::jlimit(NEGATIVE_INFINITY, MAX_DECIBELS, db), NEGATIVE_INFINITY, MAX_DECIBELS, levelBounds.getX(), levelBounds.getRight());
+        };
+
+        g.setColour(BACKGROUND_COLOR);
+        g.fillRect(levelBounds);
+        g.setColour(HIGHLIGHT_COLOR);
+        g.fillRect(levelBounds.withRight(toX(latest.getRMS(band))));
+        g.setColour(juce::Colours::white);
+        g.fillRect(juce::Rectangle<float>(toX(latest.peaks[band]) - 1.f, levelBounds.getY(), 1.f, levelBounds.getHeight()));
+
+        // Correlation bar growing from the centre, red when the band is out of phase
+        const auto correlation = latest.correlations[band];
+        const auto centre = correlationBounds.getCentreX();
+        const auto end = juce::jmap(correlation, -1.f, 1.f, correlationBounds.getX(), correlationBounds.getRight());
+
+        g.setColour(BACKGROUND_COLOR);
+        g.fillRect(correlationBounds);
+        g.setColour(correlation < 0.f ? juce::Colours::red : HIGHLIGHT_COLOR);
+        g.fillRect(juce::Rectangle<float>(juce::jmin(centre, end), correlationBounds.getY(), std::abs(end - centre), correlationBounds.getHeight()));
+        g.setColour(juce::Colours::white.withAlpha(0.5f));
+        g.fillRect(juce::Rectangle<float>(centre, correlationBounds.getY(), 1.f, correlationBounds.getHeight()));
+    }
+}
+
+void MultibandMeter::update()
+{
+    // Merge every snapshot published since the last frame
+    MultibandSnapshot snapshot, frame;
+    while (analyzer.getSnapshot(snapshot))
+    {
+        frame.merge(snapshot);
+    }
+
+    // Keep the previous frame when no audio arrived
+    if (frame.numSamples == 0)
+        return;
+
+    // Silent or static input gives the same readings, which are not repainted
+    bool changed = false;
+    for (int band = 0; band < MultibandSnapshot::numBands; ++band)
+    {
+        changed = changed || frame.peaks[band] != latest.peaks[band]
+                          || frame.getRMS(band) != latest.getRMS(band)
+                          || frame.correlations[band] != latest.correlations[band];
+    }
+
+    latest = frame;
+    if (changed)
+        repaint();
+}
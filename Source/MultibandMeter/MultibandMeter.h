@@ -0,0 +1,78 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Fifo.h"
+#include "../Constants.h"
+#include "../Profiling/PaintProfiler.h"
+#include "../DSP/BiquadBank.h"
+
+//==============================================================================
+// Per-band measurements of both channels over the same stretch of audio
+struct MultibandSnapshot
+{
+    static constexpr int numBands = 4; // Low, low mid, high mid and high
+
+    // Combines a later snapshot into this one
+    void merge(const MultibandSnapshot& other);
+
+    // Returns the RMS level of a band over both channels as a gain value
+    float getRMS(int band) const;
+
+    std::array<float, numBands> peaks {}; // Absolute sample peak of each band over both channels
+    std::array<double, numBands> sumsOfSquares {}; // Sum of the squared samples of each band over both channels
+    std::array<float, numBands> correlations {}; // Correlation of each band at the end of the snapshot
+    juce::uint32 numSamples = 0; // Number of samples per channel measured
+};
+
+//==============================================================================
+// Four-band Linkwitz-Riley (LR4) crossover with per-band level and correlation that runs
+// on the audio thread. Each band is a cascade of four biquad stages (two Butterworth
+// sections per crossover edge, with pass-through stages where a band has only one edge).
+// The 4 bands x 2 channels run as eight lanes of one BiquadBank, so four bands cost
+// about as much as one.
+struct MultibandAnalyzer
+{
+    static constexpr int numBands = MultibandSnapshot::numBands;
+    static constexpr std::array<float, numBands - 1> crossoverFrequencies { 120.f, 1000.f, 5000.f }; // Band edges in Hz
+    static constexpr float correlationTimeConstantMs = 300.f; // Time constant of the per-band correlation
+
+    // Derives the filter and integrator coefficients for the given sample rate and clears their state
+    void prepare(double sampleRate);
+
+    // Measures the given buffer, called from processBlock
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Retrieves the oldest snapshot from the FIFO
+    bool getSnapshot(MultibandSnapshot& snapshot) { return snapshotFifo.pull(snapshot); }
+
+private:
+    using CrossoverBank = BiquadBank<numBands * 2, 4>; // Lane band * 2 + channel, four sections per band
+    using IntegratorBank = BiquadBank<numBands * 3>; // L*R, L*L and R*R of every band
+
+    CrossoverBank crossover; // Band filters of both channels
+    IntegratorBank integrators; // Per-band correlation integrators, lanes band, numBands + band, 2 * numBands + band
+
+    MultibandSnapshot pending; // Measurements not yet pushed to the FIFO
+    juce::uint32 snapshotLength = 480; // Number of samples per snapshot
+    FifoSpectrumAnalyzer<MultibandSnapshot> snapshotFifo; // FIFO for publishing snapshots to the GUI
+};
+
+//==============================================================================
+// Stacked per-band bars: an RMS bar with a peak line, followed by a correlation bar
+// centred on zero, one row per band from low to high
+struct MultibandMeter : juce::Component
+{
+    // Constructor with the analyzer to display
+    MultibandMeter(MultibandAnalyzer& analyzerInput);
+
+    // Paints the component
+    void paint(juce::Graphics& g) override;
+
+    // Merges the snapshots published since the previous frame and repaints when a reading changed
+    void update();
+
+private:
+    MultibandAnalyzer& analyzer; // Analyzer providing the per-band measurements
+    MultibandSnapshot latest; // Measurements of the latest frame
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
+};
@@ -17,15 +17,20 @@
 MultiMeterAudioProcessorEditor::MultiMeterAudioProcessorEditor(MultiMeterAudioProcessor& p) :
     AudioProcessorEditor(&p),
     audioProcessor(p),
-    gonioMeter(buffer),
-    correlationMeter(buffer, audioProcessor.getSampleRate()),
+    gonioMeter(p.goniometerStream, p.stereoHeatmap, p.polarAnalyzer),
+    correlationMeter(p.correlationAnalyzer),
+    multibandMeter(p.multibandAnalyzer),
+    loudnessMeter(p.loudnessAnalyzer, "LUFS"),
+    peakDistributionHistogram(p.peakDistribution, "PEAK DISTRIBUTION"),
+    rmsDistributionHistogram(p.rmsDistribution, "RMS DISTRIBUTION"),
+    frameScheduler(p.silenceDetector),
     spectrumAnalyzer(audioProcessor),
+    profilerOverlay(p),
     scaleKnobSlider(*audioProcessor.apvts.getParameter("Scale Knob"), "%"),
     scaleKnobSliderAttachment(audioProcessor.apvts, "Scale Knob", scaleKnobSlider)
 {
-    // Timer setup
-    startTimerHz(60);
-    buffer.clear();
+    // Timer setup, the frame scheduler lowers the rate while the input is silent
+    startTimerHz(frameScheduler.getFrameRateHz());
 
     // add menu view switch and also add listener so editor can use callback to switch between three views
     // menu switch is simply added to switch between three different visuals (goniometer, spectrum analyzer and histogram)
@@ -36,17 +41,23 @@ MultiMeterAudioProcessorEditor::MultiMeterAudioProcessorEditor(MultiMeterAudioPr
     addAndMakeVisible(histogramViewButton);
     histogramViewButton.addOption("Parallel", *this);
     histogramViewButton.addOption("Stacked", *this);
+    histogramViewButton.addOption("Dist.", *this);
     //before setting the selection to the histogramview combobox make sure it is within valid range, if not then set to default
-    int histoID = (audioProcessor.histogramDisplayID > 1 || audioProcessor.histogramDisplayID < 0) ? 0 : audioProcessor.histogramDisplayID;
+    int histoID = (audioProcessor.histogramDisplayID > 2 || audioProcessor.histogramDisplayID < 0) ? 0 : audioProcessor.histogramDisplayID;
     histogramViewButton.setSelection(histoID);
 
     // Meter setup
     addAndMakeVisible(peakMeter);
     addAndMakeVisible(RMSMeter);
+    addAndMakeVisible(loudnessMeter);
+    addAndMakeVisible(statisticsPanel);
     addChildComponent(peakHistogram);
     addChildComponent(rmsHistogram);
+    addChildComponent(peakDistributionHistogram);
+    addChildComponent(rmsDistributionHistogram);
     addChildComponent(gonioMeter);
     addAndMakeVisible(correlationMeter);
+    addAndMakeVisible(multibandMeter);
     addAndMakeVisible(spectrumAnalyzer);
 
     // Scale knob setup
@@ -75,10 +86,37 @@ MultiMeterAudioProcessorEditor::MultiMeterAudioProcessorEditor(MultiMeterAudioPr
     averagerDurationSelector.addListener(this);
     validID = (audioProcessor.averagerDurationId > 5 || audioProcessor.averagerDurationId < 1) ? 1 : audioProcessor.averagerDurationId;
     averagerDurationSelector.setSelectedId(validID, juce::dontSendNotification);
+    averagerDuration = averagerDurationSelector.getText().removeCharacters("ms").getFloatValue(); //ms
+    audioProcessor.correlationAnalyzer.setSlowTimeConstant(static_cast<float>(averagerDuration));
     addAndMakeVisible(averagerDurationLabel);
     averagerDurationLabel.setText("Averager Duration", juce::NotificationType::dontSendNotification);
     averagerDurationLabel.setColour(Label::ColourIds::textColourId, Colours::black);
 
+    // Goniometer mode and heatmap window setup, only shown with the goniometer view
+    addChildComponent(goniometerModeSelector);
+    goniometerModeSelector.addItemList(juce::StringArray("Phosphor", "Heatmap", "Polar Sample", "Polar Level"), 1);
+    goniometerModeSelector.addListener(this);
+    validID = (audioProcessor.goniometerModeId > 4 || audioProcessor.goniometerModeId < 1) ? 1 : audioProcessor.goniometerModeId;
+    goniometerModeSelector.setSelectedId(validID, juce::sendNotificationSync);
+    addChildComponent(heatmapWindowSelector);
+    heatmapWindowSelector.addItemList(juce::StringArray("1 s", "5 s", "30 s"), 1);
+    heatmapWindowSelector.addListener(this);
+    validID = (audioProcessor.heatmapWindowId > 3 || audioProcessor.heatmapWindowId < 1) ? 2 : audioProcessor.heatmapWindowId;
+    heatmapWindowSelector.setSelectedId(validID, juce::sendNotificationSync);
+    addChildComponent(goniometerAutoGain);
+    goniometerAutoGain.addListener(this);
+    goniometerAutoGain.setToggleState(audioProcessor.goniometerAutoGainState, juce::dontSendNotification);
+    goniometerAutoGain.clicked();
+    gonioMeter.setAutoGain(goniometerAutoGain.getToggleState());
+
+    // Analysis rate setup, only shown with the spectrum view. The display keeps its own frame rate.
+    addChildComponent(analysisRateSelector);
+    analysisRateSelector.addItemList(juce::StringArray("15 Hz", "20 Hz", "30 Hz", "60 Hz"), 1);
+    analysisRateSelector.addListener(this);
+    validID = (audioProcessor.analysisRateId > 4 || audioProcessor.analysisRateId < 1) ? 3 : audioProcessor.analysisRateId;
+    analysisRateSelector.setSelectedId(validID, juce::sendNotificationSync);
+    analysisRateSelector.setVisible(spectrumAnalyzer.isVisible());
+
     // Meter view setup
     addAndMakeVisible(meterViewButton);
     meterViewButton.addOption("Both", *this);
@@ -105,6 +143,7 @@ MultiMeterAudioProcessorEditor::MultiMeterAudioProcessorEditor(MultiMeterAudioPr
     holdTimeSelector.addListener(this);
     validID = (audioProcessor.holdTimeId > 6 || audioProcessor.holdTimeId < 1) ? 3 : audioProcessor.holdTimeId;
     holdTimeSelector.setSelectedId(validID, juce::dontSendNotification);
+    updateSettleTime();
     addAndMakeVisible(holdTimeLabel);
     holdTimeLabel.setText("Tick Hold Duration", juce::NotificationType::dontSendNotification);
     holdTimeLabel.setColour(Label::ColourIds::textColourId, Colours::black);
@@ -131,32 +170,85 @@ MultiMeterAudioProcessorEditor::MultiMeterAudioProcessorEditor(MultiMeterAudioPr
     // Set the look and feel
     setLookAndFeel(&lookAndFeel);
 
+    // The profiler HUD is added last so it is drawn over every view, and the editor takes
+    // keyboard focus for its shortcut
+    addChildComponent(profilerOverlay);
+    setWantsKeyboardFocus(true);
+
     // Set the initial size of the editor
-    setSize(800, 400);
+    setSize(900, 434);
 }
 
 
 MultiMeterAudioProcessorEditor::~MultiMeterAudioProcessorEditor()
 {
     setLookAndFeel(nullptr);
+
+    if (startedTracing)
+        TraceRecorder::getInstance().stop();
 }
 
 void MultiMeterAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    // A paint pass starts with the editor and ends with its paintOverChildren
+    paintProfiler->beginFrame();
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Editor);
+
     // Fill the background with a solid color
     g.fillAll(BACKGROUND_COLOR);
 
 }
 
+void MultiMeterAudioProcessorEditor::paintOverChildren(juce::Graphics&)
+{
+    // Called for every repainted area, so any change on screen keeps the full frame rate
+    frameScheduler.notePaint();
+    paintProfiler->endFrame();
+}
+
+bool MultiMeterAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
+{
+    if (key == juce::KeyPress('p', juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier, 0))
+    {
+        profilerOverlay.setActive(!profilerOverlay.isVisible());
+        return true;
+    }
+
+#if ENABLE_TRACING
+    if (key == juce::KeyPress('t', juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier, 0))
+    {
+        // The trace is written to a new file on the desktop every time recording starts
+        auto& recorder = TraceRecorder::getInstance();
+        if (TraceRecorder::isRecording())
+        {
+            recorder.stop();
+            startedTracing = false;
+        }
+        else
+        {
+            startedTracing = recorder.start(TraceRecorder::getDefaultFile());
+        }
+
+        return true;
+    }
+#endif
+
+    return false;
+}
+
 void MultiMeterAudioProcessorEditor::resized()
 {
     const int gonioMeterWidth = 285;
 
-    menuViewSwitch.setBounds(0, 0, 800, 20);
+    menuViewSwitch.setBounds(0, 0, getWidth(), 20);
+
+    // Profiler HUD in the top left corner, below the view switch
+    profilerOverlay.setBounds(profilerOverlay.getPreferredSize().withPosition(4, 24));
 
     auto visualsRoom = getBounds();
     visualsRoom.removeFromTop(20);
     auto meterRoom  = visualsRoom.removeFromRight(getWidth() / 3);
+    auto statisticsRoom = meterRoom.removeFromBottom(34);
     auto controlRoom = visualsRoom.removeFromBottom(visualsRoom.getHeight() / 4);
     auto correlationRoom = meterRoom.removeFromBottom(meterRoom.getHeight() / 5);
 
@@ -172,14 +264,30 @@ void MultiMeterAudioProcessorEditor::resized()
     spectrumAnalyzer.setBounds(visualsRoom.reduced(20));
     gonioMeter.setBounds(visualsRoom.getCentreX() - gonioMeterWidth / 2, visualsRoom.getCentreY() - gonioMeterWidth / 2, gonioMeterWidth, gonioMeterWidth);
 
-    peakHistogram.setBounds(audioProcessor.histogramDisplayID ? peakStacked : peakSBS);
-    rmsHistogram.setBounds(audioProcessor.histogramDisplayID ? rmsStacked : rmsSBS);
+    // Goniometer mode controls in the top left corner of the view
+    auto gonioControls = visualsRoom.reduced(20).removeFromTop(20);
+    goniometerModeSelector.setBounds(gonioControls.removeFromLeft(110));
+    heatmapWindowSelector.setBounds(gonioControls.withTrimmedLeft(5).removeFromLeft(70));
+    goniometerAutoGain.setBounds(gonioControls.removeFromRight(90));
+
+    // Spectrum analysis rate in the top left corner of the view
+    analysisRateSelector.setBounds(visualsRoom.reduced(20).removeFromTop(20).removeFromLeft(70));
 
-    auto peakSection = meterRoom.removeFromLeft(meterRoom.getWidth() / 2).reduced(10,0);
+    updateHistogramLayout();
+
+    // The meter room holds three columns: peak, RMS and loudness
+    auto columnWidth = meterRoom.getWidth() / 3;
+    auto peakSection = meterRoom.removeFromLeft(columnWidth).reduced(10,0);
     peakMeter.setBounds(peakSection.expanded(0, 5).translated(0,25));
-    RMSMeter.setBounds(meterRoom.reduced(10,0).expanded(0, 5).translated(0,25));
+    auto rmsSection = meterRoom.removeFromLeft(columnWidth).reduced(10,0);
+    RMSMeter.setBounds(rmsSection.expanded(0, 5).translated(0,25));
+    loudnessMeter.setBounds(meterRoom.reduced(10,0).expanded(0, 5).translated(0,25));
 
-    correlationMeter.setBounds(correlationRoom.reduced(13,30).translated(0,2));
+    // The per-band bars sit to the right of the full-band correlation meter
+    auto multibandRoom = correlationRoom.removeFromRight(correlationRoom.getWidth() * 2 / 5);
+    correlationMeter.setBounds(correlationRoom.withTrimmedLeft(13).withTrimmedRight(8).reduced(0,30).translated(0,2));
+    multibandMeter.setBounds(multibandRoom.reduced(0, 6).withTrimmedRight(13));
+    statisticsPanel.setBounds(statisticsRoom.reduced(13, 2));
 
     int y = correlationMeter.getBottom();
     int wd = 24;
@@ -218,7 +326,7 @@ void MultiMeterAudioProcessorEditor::resized()
     resetHold.setBounds(tickSpace.reduced(0,1).withTrimmedLeft(2));
 
     controlRoom.removeFromLeft(10);
-    auto space1 = controlRoom.removeFromRight(130);
+    auto space1 = controlRoom.removeFromRight(165);
     histogramViewLabel.setBounds(space1.removeFromTop(delY).withTrimmedRight(10));
     histogramViewButton.setBounds(space1.removeFromTop(delY).reduced(0, 1).translated(5,0));
 
@@ -228,40 +336,64 @@ void MultiMeterAudioProcessorEditor::resized()
 
 void MultiMeterAudioProcessorEditor::timerCallback()
 {
+    ScopedTraceEvent traceEvent("message", "Editor timer");
 
-    auto& audioProcessorFifo = audioProcessor.fifo;
+    // The HUD samples the FIFOs before the views drain them, and counts ticks that came late
+    if (profilerOverlay.isVisible())
+        profilerOverlay.update(1000.0 / frameScheduler.getFrameRateHz());
 
-    // If the audioProcessor.fifo has items available for reading
-    if (/*JUCE_WINDOWS ||*/ audioProcessorFifo.getNumAvailableForReading() > 0)
+    // Drop to the idle rate once the input is silent and the meters have settled, and
+    // return to the full rate on the first tick that sees audio or a repaint
+    if (frameScheduler.update())
     {
-        // Use a while( fifo.pull(buffer) ) loop to pull every element available out of the fifo
-        while (audioProcessorFifo.pull(buffer))
+        startTimerHz(frameScheduler.getFrameRateHz());
+        spectrumAnalyzer.setIdle(frameScheduler.isIdle());
+    }
+
+    const bool idle = frameScheduler.isIdle();
+
+    // Merge every statistics snapshot the audio thread published since the last frame,
+    // so the meters see all of the audio rather than only the latest block
+    StatisticsSnapshot snapshot, frame;
+    bool hasNewFrame = false;
+    {
+        ScopedTraceEvent pullEvent("fifo", "Statistics FIFO pull");
+        while (audioProcessor.signalStatistics.getSnapshot(snapshot))
         {
+            frame.merge(snapshot);
+            hasNewFrame = true;
         }
     }
-    
-    // After finishing pulling all buffers out of the fifo in timerCallback,
-    // use the buffer’s member function that returns the magnitude for a channel to get
-    // the Left channel’s magnitude
-    // This function returns a "gain" value.f
-    float leftChannelMagnitudeRaw = buffer.getMagnitude(0, 0, buffer.getNumSamples());
-    float rightChannelMagnitudeRaw = buffer.getMagnitude(1, 0, buffer.getNumSamples());
-    
-    float leftChannelRMSRaw = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
-    float rightChannelRMSRaw = buffer.getRMSLevel(1, 0, buffer.getNumSamples());
-
-    // Convert this value to decibels
-    // The juce::Decibels::gainToDecibels() function takes a 2nd parameter
-    // This 2nd parameter lets you define what "negative infinity" is, which is NEGATIVE_INFINITY
-    float leftChannelMagnitudeDecibels = juce::Decibels::gainToDecibels(leftChannelMagnitudeRaw,
-                                                                        NEGATIVE_INFINITY);
-    float rightChannelMagnitudeDecibels = juce::Decibels::gainToDecibels(rightChannelMagnitudeRaw,
-                                                                         NEGATIVE_INFINITY);
-    
-    float leftChannelRMSDecibels = juce::Decibels::gainToDecibels(leftChannelRMSRaw,
-                                                                  NEGATIVE_INFINITY);
-    float rightChannelRMSDecibels = juce::Decibels::gainToDecibels(rightChannelRMSRaw,
-                                                                  NEGATIVE_INFINITY);
+
+    if (hasNewFrame)
+    {
+        statisticsFrame = frame;
+        statisticsPanel.update(frame, audioProcessor.getSampleRate(), audioProcessor.loudnessAnalyzer.getIntegratedLoudness());
+
+        // Peak and RMS come from the single-pass statistics as "gain" values
+        // The juce::Decibels::gainToDecibels() function takes a 2nd parameter
+        // This 2nd parameter lets you define what "negative infinity" is, which is NEGATIVE_INFINITY
+        auto toDecibels = [](float gain) { return juce::Decibels::gainToDecibels(gain, NEGATIVE_INFINITY); };
+        levelFrames.push({ toDecibels(frame.channels[0].getPeak()), toDecibels(frame.channels[1].getPeak()),
+                           toDecibels(frame.channels[0].getRMS()), toDecibels(frame.channels[1].getRMS()) },
+                         frame.timeMs);
+    }
+
+    // When the host delivers large blocks, frames arrive less often than the display
+    // refreshes, and the meters move between the two latest frames instead of stepping
+    std::array<float, 4> levels;
+    levels.fill(NEGATIVE_INFINITY);
+    if (levelFrames.hasFrame())
+    {
+        const float proportion = levelFrames.getProportion(juce::Time::getMillisecondCounterHiRes(), 1000.0 / FrameScheduler::fullRateHz);
+        FrameInterpolator<std::array<float, 4>>::interpolate(levelFrames.getPrevious().data(), levelFrames.getLatest().data(),
+            proportion, levels.data(), static_cast<int>(levels.size()));
+    }
+
+    float leftChannelMagnitudeDecibels = levels[0];
+    float rightChannelMagnitudeDecibels = levels[1];
+    float leftChannelRMSDecibels = levels[2];
+    float rightChannelRMSDecibels = levels[3];
     
     // In this section, control values are updated using the TimerCallback mechanism
 
@@ -269,25 +401,38 @@ void MultiMeterAudioProcessorEditor::timerCallback()
     // These parameters are updated via corresponding listener functions, such as ComboBoxChanged or SliderValueChanged
     peakMeter.update(leftChannelMagnitudeDecibels, rightChannelMagnitudeDecibels, currentDecayRate, audioProcessor.levelMeterDisplayID, tickDisplay.getToggleState(), holdTime, resetHold.getToggleState());
     RMSMeter.update(leftChannelRMSDecibels, rightChannelRMSDecibels, currentDecayRate, audioProcessor.levelMeterDisplayID, tickDisplay.getToggleState(), holdTime, resetHold.getToggleState());
+    loudnessMeter.update(currentDecayRate, tickDisplay.getToggleState(), holdTime, resetHold.getToggleState());
 
     // Resetting the resetHold button to false state to prevent it from toggling
     if (resetHold.getToggleState())
         resetHold.setToggleState(false, juce::dontSendNotification);
 
-    // Updating peak and RMS histograms with the average of left and right channel RMS and peak values
-    peakHistogram.update((leftChannelMagnitudeDecibels + rightChannelMagnitudeDecibels) / 2);
-    rmsHistogram.update((leftChannelRMSDecibels + rightChannelRMSDecibels) / 2);
+    // Updating peak and RMS histograms with the average of left and right channel RMS and peak values.
+    // An idle tick stands for several frames, so the history keeps its time scale.
+    const int numHistogramFrames = idle ? FrameScheduler::fullRateHz / FrameScheduler::idleRateHz : 1;
+    for (int step = 0; step < numHistogramFrames; ++step)
+    {
+        peakHistogram.update((leftChannelMagnitudeDecibels + rightChannelMagnitudeDecibels) / 2);
+        rmsHistogram.update((leftChannelRMSDecibels + rightChannelRMSDecibels) / 2);
+    }
 
-    // Updating the correlation averager with the new duration every time the TimerCallback is invoked
-    correlationMeter.update(averagerDuration);
+    // Updating the level distributions with the counts gathered on the audio thread
+    peakDistributionHistogram.update();
+    rmsDistributionHistogram.update();
+
+    // Updating the correlation meter with the readings measured on the audio thread
+    correlationMeter.update();
+    multibandMeter.update();
 
     // Scaling knob values are mapped to a range of 50 - 200
     // This value is used as a gain factor in the updateCoeff function of the gonioMeter
     float gain = scaleKnobSlider.getValue() / 100;
     gonioMeter.updateCoeff(gain); // Scaling the gonioMeter plot
 
-    // Triggering a repaint for the gonioMeter
-    gonioMeter.repaint();
+    // Plotting the latest point stream frame into the gonioMeter phosphor, which also repaints it.
+    // A settled goniometer shows a still image, so nothing is rendered while idle.
+    if (!idle)
+        gonioMeter.update();
 }
 
 void MultiMeterAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBox)
@@ -309,6 +454,7 @@ void MultiMeterAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBox)
     {
         averagerDuration = comboBox->getItemText(comboBox->getSelectedId() - 1).removeCharacters("ms").getFloatValue(); //ms
         audioProcessor.averagerDurationId = comboBox->getSelectedId();
+        audioProcessor.correlationAnalyzer.setSlowTimeConstant(static_cast<float>(averagerDuration));
     }
     else if (comboBox == &holdTimeSelector)
     {
@@ -327,6 +473,26 @@ void MultiMeterAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBox)
         // Converting hold time to milliseconds and storing the selected ID in the value tree
         holdTime *= 1000;
         audioProcessor.holdTimeId = comboBox->getSelectedId();
+        updateSettleTime();
+    }
+    else if (comboBox == &goniometerModeSelector)
+    {
+        // The items are listed in the order of the goniometer modes
+        gonioMeter.setMode(static_cast<Goniometer::Mode>(comboBox->getSelectedId() - 1));
+        audioProcessor.goniometerModeId = comboBox->getSelectedId();
+        updateGoniometerControls();
+    }
+    else if (comboBox == &heatmapWindowSelector)
+    {
+        // Window length in seconds is taken from the item text
+        audioProcessor.stereoHeatmap.setWindow(comboBox->getText().removeCharacters(" s").getFloatValue());
+        audioProcessor.heatmapWindowId = comboBox->getSelectedId();
+    }
+    else if (comboBox == &analysisRateSelector)
+    {
+        // Rate in frames per second is taken from the item text
+        spectrumAnalyzer.setAnalysisRate(comboBox->getText().removeCharacters(" Hz").getFloatValue());
+        audioProcessor.analysisRateId = comboBox->getSelectedId();
     }
 }
 
@@ -337,6 +503,11 @@ void MultiMeterAudioProcessorEditor::buttonClicked(juce::Button* button)
         // This variable is used on plugin set and get state to load and retrieve the tick show/hide state
         audioProcessor.tickDisplayState = button->getToggleState();
     }
+    else if (button == &goniometerAutoGain)
+    {
+        gonioMeter.setAutoGain(button->getToggleState());
+        audioProcessor.goniometerAutoGainState = button->getToggleState();
+    }
     else
     {
         // All the buttonclicked callback are called so that they get's updated
@@ -350,9 +521,9 @@ void MultiMeterAudioProcessorEditor::buttonClicked(juce::Button* button)
 
         // Based on the updated id value one of the visual is set to visible and other are hide
         spectrumAnalyzer.setVisible(id == 1);
-        peakHistogram.setVisible(id == 2);
-        rmsHistogram.setVisible(id == 2);
         gonioMeter.setVisible(id == 0);
+        analysisRateSelector.setVisible(id == 1);
+        updateGoniometerControls();
 
         // After buttonclicked is called levelmeter id and histogrami id are updated to use it for later
         audioProcessor.levelMeterDisplayID = meterViewButton.getSelectedId();
@@ -360,8 +531,44 @@ void MultiMeterAudioProcessorEditor::buttonClicked(juce::Button* button)
     }
 
     // Histogram view is swtiched whenever the button is clicked 
-    peakHistogram.setBounds(audioProcessor.histogramDisplayID ? peakStacked : peakSBS);
-    rmsHistogram.setBounds(audioProcessor.histogramDisplayID ? rmsStacked : rmsSBS);
+    updateHistogramLayout();
+}
+
+void MultiMeterAudioProcessorEditor::updateHistogramLayout()
+{
+    // Histogram display 0 and 1 show the levels over time side by side or stacked,
+    // display 2 shows the level distributions stacked so the bar charts get the full width
+    bool histogramViewVisible = menuViewSwitch.getSwitchID() == 2;
+    bool showDistribution = audioProcessor.histogramDisplayID == 2;
+
+    peakHistogram.setBounds(audioProcessor.histogramDisplayID == 1 ? peakStacked : peakSBS);
+    rmsHistogram.setBounds(audioProcessor.histogramDisplayID == 1 ? rmsStacked : rmsSBS);
+    peakDistributionHistogram.setBounds(peakStacked);
+    rmsDistributionHistogram.setBounds(rmsStacked);
+
+    peakHistogram.setVisible(histogramViewVisible && !showDistribution);
+    rmsHistogram.setVisible(histogramViewVisible && !showDistribution);
+    peakDistributionHistogram.setVisible(histogramViewVisible && showDistribution);
+    rmsDistributionHistogram.setVisible(histogramViewVisible && showDistribution);
+}
+
+void MultiMeterAudioProcessorEditor::updateGoniometerControls()
+{
+    // The heatmap window only applies to the heatmap mode
+    bool goniometerViewVisible = menuViewSwitch.getSwitchID() == 0;
+    goniometerModeSelector.setVisible(goniometerViewVisible);
+    heatmapWindowSelector.setVisible(goniometerViewVisible && goniometerModeSelector.getSelectedId() == 2);
+
+    // The automatic gain follows the level measured while plotting the phosphor
+    goniometerAutoGain.setVisible(goniometerViewVisible && goniometerModeSelector.getSelectedId() == 1);
+}
+
+void MultiMeterAudioProcessorEditor::updateSettleTime()
+{
+    // A held tick only changes again when the hold time ends, an infinite hold never does
+    const bool isInfiniteHold = holdTimeSelector.getSelectedId() == holdTimeSelector.getNumItems();
+    const float holdSeconds = holdTimeSelector.getText().removeCharacters("s").getFloatValue();
+    frameScheduler.setSettleTime(isInfiniteHold ? 0 : juce::roundToInt(holdSeconds * 1000.f) + 500);
 }
 
 void MultiMeterAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
@@ -370,5 +577,9 @@ void MultiMeterAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
     if (slider == &scaleKnobSlider)
     {
         audioProcessor.sliderValue = slider->getValue();
+
+        // Turning the knob by hand overrides the automatic gain
+        if (goniometerAutoGain.getToggleState() && slider->isMouseButtonDown())
+            goniometerAutoGain.setToggleState(false, juce::sendNotificationSync);
     }
 }
@@ -16,8 +16,14 @@
 #include "SpectrumAnalyzer/SpectrumAnalyzer.h"
 #include "LevelMeter/LevelMeter.h"
 #include "CorrelationMeter/CorrelationMeter.h"
+#include "LoudnessMeter/LoudnessMeter.h"
+#include "SignalStatistics/SignalStatistics.h"
+#include "MultibandMeter/MultibandMeter.h"
 #include "Controls/Buttons.h"
 #include "Controls/Slider.h"
+#include "Analysis/FrameInterpolator.h"
+#include "Profiling/ProfilerOverlay.h"
+#include "Profiling/TraceRecorder.h"
  
 //==============================================================================
 class MultiMeterAudioProcessorEditor  : public juce::AudioProcessorEditor, juce::Timer, juce::ComboBox::Listener, juce::ToggleButton::Listener, juce::Slider::Listener
@@ -28,6 +34,13 @@ public:
     
     void paint(juce::Graphics&) override;
 
+    // Notes every repaint of the editor or its children for the frame scheduler
+    void paintOverChildren(juce::Graphics&) override;
+
+    // Shows or hides the profiler HUD with Ctrl+Shift+P, and starts or stops tracing with
+    // Ctrl+Shift+T (Cmd instead of Ctrl on macOS)
+    bool keyPressed(const juce::KeyPress& key) override;
+
     void resized() override;
 
     void timerCallback() override;
@@ -35,8 +48,16 @@ public:
     void comboBoxChanged(juce::ComboBox* comboBox) override;
     void buttonClicked(juce::Button* button) override;
     void sliderValueChanged(juce::Slider* slider) override;
+
+    // Sets the bounds and visibility of the level and distribution histograms
+    void updateHistogramLayout();
+
+    // Sets the visibility of the goniometer mode and heatmap window selectors
+    void updateGoniometerControls();
+
+    // Sets the time the meters may keep changing after the input fell silent from the hold time
+    void updateSettleTime();
     
-    juce::AudioBuffer<float> buffer{2, 256};
     StereoMeter peakMeter{"PEAK"}, RMSMeter{"RMS"};
     Histogram peakHistogram{"PEAK"}, rmsHistogram{"RMS"};
     
@@ -45,14 +66,36 @@ private:
     MultiMeterAudioProcessor& audioProcessor;
     Goniometer gonioMeter;
     CorrelationMeter correlationMeter;
+    MultibandMeter multibandMeter;
+    LoudnessMeter loudnessMeter;
+    StatisticsPanel statisticsPanel;
+    DistributionHistogram peakDistributionHistogram, rmsDistributionHistogram;
+
+    // Signal statistics of the latest frame, merged from every snapshot published since the previous frame
+    StatisticsSnapshot statisticsFrame;
+
+    // Peak and RMS levels in decibels of the two latest frames, left and right, for interpolating the meters
+    FrameInterpolator<std::array<float, 4>> levelFrames;
+
+    // Switches the timer between the full and the idle frame rate
+    FrameScheduler frameScheduler;
     ResponseCurveComponent spectrumAnalyzer;
 
+    // Paint times of the views, and the HUD showing them over the other components
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler;
+    ProfilerOverlay profilerOverlay;
+
+    // Whether this editor started the trace recording, which it then stops when it closes
+    bool startedTracing = false;
+
     ButtonsLook lookAndFeel;
     SwitchButton menuViewSwitch;
 
     // All combobox controls are defined here
     juce::ComboBox levelMeterDecaySelector, averagerDurationSelector, holdTimeSelector;
+    juce::ComboBox goniometerModeSelector, heatmapWindowSelector, analysisRateSelector;
     Switch tickDisplay{ "Hide Tick","Show Tick" }, resetHold{"Reset Hold","Reset Hold"};
+    Switch goniometerAutoGain{ "Auto Gain", "Manual Gain" };
 
     ToggleChain histogramViewButton, meterViewButton;
 
@@ -9,6 +9,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "DSP/Benchmarks.h"
 
 //==============================================================================
 MultiMeterAudioProcessor::MultiMeterAudioProcessor()
@@ -28,6 +29,13 @@ MultiMeterAudioProcessor::MultiMeterAudioProcessor()
         "Parameters",
         createParameterLayout())
 {
+    analysisThread.addAnalysis(goniometerStream);
+    analysisThread.addAnalysis(stereoHeatmap);
+    analysisThread.addAnalysis(polarAnalyzer);
+
+#if RUN_BENCHMARKS
+    Benchmarks::runAll();
+#endif
 }
 
 MultiMeterAudioProcessor::~MultiMeterAudioProcessor()
@@ -101,11 +109,20 @@ void MultiMeterAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 {
     // Use this method as the place to do any pre-playback initialization
     
-    // Prepare the Fifo<> instance in prepareToPlay()
-    fifo.prepare(sampleRate, getTotalNumOutputChannels());
-    
     leftChannelFifo.prepare(samplesPerBlock);
     rightChannelFifo.prepare(samplesPerBlock);
+
+    // Prepare the K-weighting filters and gating blocks for the new sample rate
+    loudnessAnalyzer.prepare(sampleRate, getTotalNumInputChannels());
+    signalStatistics.prepare(sampleRate);
+    peakDistribution.prepare(sampleRate);
+    rmsDistribution.prepare(sampleRate);
+    correlationAnalyzer.prepare(sampleRate);
+    multibandAnalyzer.prepare(sampleRate);
+    realTimeAnalyzer.prepare(sampleRate);
+
+    // Restart the analysis thread with every analysis prepared for the new sample rate
+    analysisThread.prepare(sampleRate);
     
     #if USE_OSC
         juce::dsp::ProcessSpec spec;
@@ -153,6 +170,11 @@ bool MultiMeterAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 void MultiMeterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+
+    // Time the whole block against its budget, the stages below are timed separately
+    blockProfiler.beginBlock(buffer.getNumSamples(), getSampleRate());
+    ScopedStageTimer blockTimer(blockProfiler, BlockProfiler::Block);
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -178,12 +200,59 @@ void MultiMeterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     gain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
     #endif
     
-    // Push the current audio buffer to the FIFO for processing
-    fifo.push(buffer);
+    // Measure the signal statistics of the current audio buffer in a single pass, and count the
+    // averaged left and right levels of the block in the level distributions
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::Statistics);
+        signalStatistics.process(buffer);
+
+        auto& channels = signalStatistics.getBlockStatistics().channels;
+        auto toDecibels = [](float gain) { return juce::Decibels::gainToDecibels(gain, NEGATIVE_INFINITY); };
+
+        peakDistribution.add((toDecibels(channels[0].getPeak()) + toDecibels(channels[1].getPeak())) / 2, buffer.getNumSamples());
+        rmsDistribution.add((toDecibels(channels[0].getRMS()) + toDecibels(channels[1].getRMS())) / 2, buffer.getNumSamples());
+
+        // Flag the block as silent or not from the same peaks
+        silenceDetector.process(juce::jmax(channels[0].getPeak(), channels[1].getPeak()));
+    }
 
     // Update the left and right channel FIFOs with the current audio buffer
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    if (spectrumInterest.isWanted())
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::SpectrumFifo);
+        leftChannelFifo.update(buffer);
+        rightChannelFifo.update(buffer);
+    }
+
+    // Measure the loudness of the current audio buffer
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::Loudness);
+        loudnessAnalyzer.process(buffer);
+    }
+
+    // Correlate every sample of the current audio buffer
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::Correlation);
+        correlationAnalyzer.process(buffer);
+    }
+
+    // Split the current audio buffer into bands and measure each of them
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::Multiband);
+        multibandAnalyzer.process(buffer);
+    }
+
+    // Filter the current audio buffer into 1/3-octave bands when the RTA view is shown
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::RealTimeAnalyzer);
+        realTimeAnalyzer.process(buffer);
+    }
+
+    // Hand the current audio buffer to the analysis thread
+    {
+        ScopedStageTimer timer(blockProfiler, BlockProfiler::AnalysisPush);
+        analysisThread.push(buffer);
+    }
 
 #if USE_OSC
     // Clear the audio buffer if oscillator synthesis is used
@@ -216,6 +285,10 @@ void MultiMeterAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     stream.writeInt(averagerDurationId);
     stream.writeInt(levelMeterDisplayID);
     stream.writeInt(histogramDisplayID);
+    stream.writeInt(goniometerModeId);
+    stream.writeInt(heatmapWindowId);
+    stream.writeBool(goniometerAutoGainState);
+    stream.writeInt(analysisRateId);
 }
 
 void MultiMeterAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -231,6 +304,10 @@ void MultiMeterAudioProcessor::setStateInformation(const void* data, int sizeInB
     averagerDurationId = stream.readInt();
     levelMeterDisplayID = stream.readInt();
     histogramDisplayID = stream.readInt();
+    goniometerModeId = stream.readInt();
+    heatmapWindowId = stream.readInt();
+    goniometerAutoGainState = stream.readBool();
+    analysisRateId = stream.readInt();
 }
 
 //==============================================================================
@@ -12,8 +12,25 @@
 // Macro used for testing.
 #define USE_OSC false
 
+// Macro used to log the DSP benchmarks when the processor is created.
+#define RUN_BENCHMARKS false
+
 #include <JuceHeader.h>
 #include <array>
+#include "Fifo.h"
+#include "LoudnessMeter/LoudnessMeter.h"
+#include "SignalStatistics/SignalStatistics.h"
+#include "Histogram/Histogram.h"
+#include "CorrelationMeter/CorrelationMeter.h"
+#include "MultibandMeter/MultibandMeter.h"
+#include "SpectrumAnalyzer/RealTimeAnalyzer.h"
+#include "Analysis/AnalysisThread.h"
+#include "Analysis/ViewInterest.h"
+#include "Analysis/FrameScheduler.h"
+#include "GonioMeter/StereoHeatmap.h"
+#include "GonioMeter/GoniometerStream.h"
+#include "GonioMeter/PolarAnalyzer.h"
+#include "Profiling/BlockProfiler.h"
 
 using namespace juce;
 
@@ -21,138 +38,6 @@ using Filter = juce::dsp::IIR::Filter<float>;
 using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
 using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, Filter, Filter, CutFilter>;
 
-//==============================================================================
-// A standard AbstractFifo-based templated FIFO class
-template<typename T, size_t Size>
-struct Fifo
-{
-    // Returns the fixed size of the FIFO buffer.
-    size_t getSize() const noexcept { return Size; }
-
-    // Prepares the FIFO buffer for writing with the given number of samples and channels
-    void prepare(int numSamples, int numChannels)
-    {
-        for (auto& buffer : buffers)
-        {
-            buffer.setSize(numChannels,
-                numSamples,
-                false, // clearUnusedChannels
-                true,  // allocateExtraSpace
-                true); // avoidReallocating
-            buffer.clear();
-        }
-    }
-
-    // Pushes an element into the FIFO buffer
-    bool push(const T& t)
-    {
-        auto write = fifo.read(1);
-        if (write.blockSize1 > 0)
-        {
-            buffers[write.startIndex1] = t;
-            return true;
-        }
-        return false;
-    }
-
-    // Pulls an element from the FIFO buffer
-    bool pull(T& t)
-    {
-        auto read = fifo.write(1);
-        if (read.blockSize1 > 0)
-        {
-            t = buffers[read.startIndex1];
-            return true;
-        }
-        return false;
-    }
-
-    // Returns the number of elements available for reading from the FIFO buffer
-    int getNumAvailableForReading() const
-    {
-        // TODO:
-        // If you are using MacOS and the meters are not responding to the audio signals,
-        // try removing the return keyword
-        return fifo.getNumReady();
-    }
-
-    // Returns the available space in the FIFO buffer for writing
-    int getAvailableSpace() const
-    {
-        // TODO:
-        // If you are using MacOS and the meters are not responding to the audio signals
-        // try removing the return keyword
-        return fifo.getFreeSpace();
-    }
-
-private:
-    juce::AbstractFifo fifo{Size}; // AbstractFifo object to manage buffer read/write positions
-    std::array<T, Size> buffers; // Array of buffers to store data elements
-};
-
-//==============================================================================
-template<typename T>
-struct FifoSpectrumAnalyzer
-{
-    // Prepares the analyzer with the given number of channels and samples per channel
-    void prepare(int numChannels, int numSamples)
-    {
-        for (auto& buffer : buffers)
-        {
-            buffer.setSize(numChannels, numSamples, false, true, true);
-            buffer.clear();
-        }
-    }
-
-    // Prepares the analyzer with the specified number of elements for each channel
-    void prepare(size_t numElements)
-    {
-        for (auto& buffer : buffers)
-        {
-            buffer.clear();
-            buffer.resize(numElements, 0);
-        }
-    }
-
-    // Pushes an element into the analyzer's FIFO buffer
-    bool push(const T& t)
-    {
-        auto write = fifo.write(1);
-        if (write.blockSize1 > 0)
-        {
-            buffers[write.startIndex1] = t;
-            return true;
-        }
-
-        return false;
-    }
-
-    // Pulls an element from the analyzer's FIFO buffer
-    bool pull(T& t)
-    {
-        auto read = fifo.read(1);
-        if (read.blockSize1 > 0)
-        {
-            t = buffers[read.startIndex1];
-            return true;
-        }
-
-        return false;
-    }
-
-    // Returns the number of elements available for reading from the FIFO buffer
-    int getNumAvailableForReading() const
-    {
-        return fifo.getNumReady();
-    }
-
-private:
-    static constexpr int Capacity = 30; // Capacity of the FIFO buffer
-    std::array<T, Capacity> buffers;    // Array of buffers to store data elements
-    juce::AbstractFifo fifo {Capacity};  // AbstractFifo object to manage buffer read/write positions
-};
-
-
 //==============================================================================
 enum Channel
 {
@@ -300,8 +185,45 @@ public:
     // FIFO for storing samples from the right channel
     SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
 
-    // FIFO for storing audio buffers
-    Fifo<juce::AudioBuffer<float>, 30> fifo;
+    // Views showing the FFT curves, the channel FIFOs are only fed while one is registered
+    ViewInterest spectrumInterest;
+
+    // Silence flag of every block, used by the editor to idle while the input is silent
+    SilenceDetector silenceDetector;
+
+    // EBU R128 loudness measurement running on the audio thread
+    LoudnessAnalyzer loudnessAnalyzer;
+
+    // Single-pass peak, RMS, DC, zero-crossing and clip measurement running on the audio thread
+    SignalStatistics signalStatistics;
+
+    // Distributions of the averaged peak and RMS levels of each block
+    LevelDistribution peakDistribution, rmsDistribution;
+
+    // Fast and slow stereo correlation measured on the audio thread
+    CorrelationAnalyzer correlationAnalyzer;
+
+    // Per-band level and correlation behind a four-band crossover
+    MultibandAnalyzer multibandAnalyzer;
+
+    // 31-band 1/3-octave analyzer, enabled while the RTA view is shown
+    RealTimeAnalyzer realTimeAnalyzer;
+
+    // Time-windowed points of the goniometer, thinned on the analysis thread
+    GoniometerStream goniometerStream;
+
+    // Stereo position and level of every sample for the polar goniometer modes
+    PolarAnalyzer polarAnalyzer;
+
+    // M/S density of the goniometer heatmap, accumulated on the analysis thread
+    StereoHeatmap stereoHeatmap;
+
+    // Thread running the analyses that are too heavy for the audio thread. It is declared
+    // after the analyses it runs, so it is stopped before they are destroyed.
+    AnalysisThread analysisThread;
+
+    // Cost of processBlock and its stages against the block budget, measured while the profiler HUD is shown
+    BlockProfiler blockProfiler;
 
     // Value of the slider
     float sliderValue;
@@ -312,6 +234,15 @@ public:
     // IDs for various parameters
     int levelMeterDecayId, holdTimeId, averagerDurationId, levelMeterDisplayID, histogramDisplayID;
 
+    // IDs of the goniometer mode and heatmap window selections
+    int goniometerModeId = 1, heatmapWindowId = 2;
+
+    // Whether the goniometer follows the signal level instead of the scale knob
+    bool goniometerAutoGainState = false;
+
+    // ID of the spectrum analysis rate selection
+    int analysisRateId = 3;
+
 #if USE_OSC
     // Oscillator for generating test signals
     juce::dsp::Oscillator<float> osc {[](float x) { return std::sin(x); }};
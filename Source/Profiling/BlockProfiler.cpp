@@ -0,0 +1,153 @@
+#include "BlockProfiler.h"
+
+//==============================================================================
+// Implementation for the BlockProfiler class
+BlockProfiler::BlockProfiler()
+{
+    // Half-octave edges placed so that the edge of budgetBucket is exactly 100 %
+    for (int bucket = 0; bucket < numBuckets - 1; ++bucket)
+        upperEdges[static_cast<size_t>(bucket)] = 100.0 * std::pow(2.0, (bucket - budgetBucket) / 2.0);
+
+    ticksPerSecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}
+
+void BlockProfiler::setEnabled(bool shouldBeEnabled)
+{
+    // The counts keep running, enabling only moves the start of the next summary
+    if (shouldBeEnabled && !isEnabled())
+    {
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            previousHistograms[static_cast<size_t>(stage)] = getHistogram(static_cast<Stage>(stage));
+            previousPercentSums[static_cast<size_t>(stage)] = stages[static_cast<size_t>(stage)].percentSum.load(std::memory_order_relaxed);
+        }
+    }
+
+    enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+}
+
+void BlockProfiler::beginBlock(int numSamples, double sampleRate)
+{
+    measuringBlock = isEnabled() && numSamples > 0 && sampleRate > 0.0;
+    if (!measuringBlock)
+        return;
+
+    const double blockSeconds = numSamples / sampleRate;
+    percentPerTick = 100.0 / (blockSeconds * ticksPerSecond);
+    budgetMs.store(blockSeconds * 1000.0, std::memory_order_relaxed);
+}
+
+void BlockProfiler::addStageTime(Stage stage, juce::int64 ticks)
+{
+    const double percent = static_cast<double>(ticks) * percentPerTick;
+    auto& counts = stages[static_cast<size_t>(stage)];
+
+    // The audio thread is the only writer, so no read-modify-write is needed
+    auto& bucket = counts.buckets[static_cast<size_t>(getBucket(percent))];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    counts.percentSum.store(counts.percentSum.load(std::memory_order_relaxed) + percent, std::memory_order_relaxed);
+}
+
+BlockProfiler::Histogram BlockProfiler::getHistogram(Stage stage) const
+{
+    Histogram histogram;
+    const auto& buckets = stages[static_cast<size_t>(stage)].buckets;
+    for (int bucket = 0; bucket < numBuckets; ++bucket)
+        histogram[static_cast<size_t>(bucket)] = buckets[static_cast<size_t>(bucket)].load(std::memory_order_relaxed);
+
+    return histogram;
+}
+
+double BlockProfiler::getBucketUpperPercent(int bucket)
+{
+    if (bucket >= numBuckets - 1)
+        return std::numeric_limits<double>::infinity();
+
+    return 100.0 * std::pow(2.0, (bucket - budgetBucket) / 2.0);
+}
+
+BlockProfiler::Summary BlockProfiler::takeSummary()
+{
+    Summary summary;
+    summary.budgetMs = budgetMs.load(std::memory_order_relaxed);
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const auto index = static_cast<size_t>(stage);
+        const auto histogram = getHistogram(static_cast<Stage>(stage));
+        const double percentSum = stages[index].percentSum.load(std::memory_order_relaxed);
+
+        // Unsigned differences stay correct when the counts wrap around
+        Histogram period;
+        juce::uint32 numBlocks = 0;
+        for (int bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            const auto b = static_cast<size_t>(bucket);
+            period[b] = histogram[b] - previousHistograms[index][b];
+            numBlocks += period[b];
+        }
+
+        auto& stageSummary = summary.stages[index];
+        if (numBlocks > 0)
+        {
+            auto percentile = [&period, numBlocks](double proportion)
+            {
+                const auto rank = static_cast<juce::uint32>(proportion * (numBlocks - 1));
+                juce::uint32 count = 0;
+                for (int bucket = 0; bucket < numBuckets; ++bucket)
+                {
+                    count += period[static_cast<size_t>(bucket)];
+                    if (count > rank)
+                        return getBucketUpperPercent(bucket);
+                }
+
+                return getBucketUpperPercent(numBuckets - 1);
+            };
+
+            stageSummary.meanPercent = (percentSum - previousPercentSums[index]) / numBlocks;
+            stageSummary.p50Percent = percentile(0.5);
+            stageSummary.p99Percent = percentile(0.99);
+            stageSummary.maxPercent = percentile(1.0);
+        }
+
+        if (stage == Block)
+        {
+            summary.numBlocks = numBlocks;
+            for (int bucket = budgetBucket + 1; bucket < numBuckets; ++bucket)
+                summary.overBudgetBlocks += period[static_cast<size_t>(bucket)];
+        }
+
+        previousHistograms[index] = histogram;
+        previousPercentSums[index] = percentSum;
+    }
+
+    return summary;
+}
+
+const char* BlockProfiler::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Block: return "processBlock";
+        case Statistics: return "Statistics";
+        case SpectrumFifo: return "Spectrum FIFO";
+        case Loudness: return "Loudness";
+        case Correlation: return "Correlation";
+        case Multiband: return "Multiband";
+        case RealTimeAnalyzer: return "RTA";
+        case AnalysisPush: return "Analysis push";
+        case numStages: break;
+    }
+
+    return "";
+}
+
+int BlockProfiler::getBucket(double percent) const
+{
+    // Few enough edges that a linear search is cheaper than a logarithm
+    int bucket = 0;
+    while (bucket < numBuckets - 1 && percent > upperEdges[static_cast<size_t>(bucket)])
+        ++bucket;
+
+    return bucket;
+}
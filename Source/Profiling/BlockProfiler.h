@@ -0,0 +1,139 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "TraceRecorder.h"
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Cost of processBlock and of every analysis stage it runs, measured against the real-time
+// budget of the block, which is its number of samples divided by the sample rate. Every
+// measurement is counted in a histogram of fixed buckets spaced half an octave apart, from
+// under 0.1 % to over 200 % of the budget. The audio thread is the only writer of the
+// counts, so it updates them with plain atomic loads and stores, and the GUI reads them
+// without locking. Nothing is measured until the profiler is enabled, which the HUD does
+// while it is shown.
+struct BlockProfiler
+{
+    // Parts of processBlock that are timed separately
+    enum Stage
+    {
+        Block, // The whole of processBlock
+        Statistics, // Signal statistics, level distributions and silence detection
+        SpectrumFifo, // Push of the samples into the spectrum FIFOs
+        Loudness, // Loudness measurement
+        Correlation, // Stereo correlation
+        Multiband, // Crossover and per-band measurement
+        RealTimeAnalyzer, // 1/3-octave filter bank
+        AnalysisPush, // Copy of the block into the ring of the analysis thread
+        numStages
+    };
+
+    static constexpr int numBuckets = 24; // Buckets of every histogram, the last one counts everything over 200 %
+    static constexpr int budgetBucket = 20; // Bucket whose upper edge is exactly 100 % of the budget
+
+    // Number of blocks counted in each bucket
+    using Histogram = std::array<juce::uint32, numBuckets>;
+
+    // Statistics of one stage over a period
+    struct StageSummary
+    {
+        double meanPercent = 0.0; // Mean share of the budget
+        double p50Percent = 0.0; // Upper edge of the bucket holding the median
+        double p99Percent = 0.0; // Upper edge of the bucket holding the 99th percentile
+        double maxPercent = 0.0; // Upper edge of the highest bucket counted
+    };
+
+    // Statistics of every stage since the previous summary, taken by the HUD
+    struct Summary
+    {
+        std::array<StageSummary, numStages> stages {}; // Statistics of each stage
+        juce::uint32 numBlocks = 0; // Blocks measured in the period
+        juce::uint32 overBudgetBlocks = 0; // Blocks whose processBlock took longer than their budget
+        double budgetMs = 0.0; // Budget of the latest block
+    };
+
+    // Constructor
+    BlockProfiler();
+
+    // Starts or stops measuring, called from the message thread
+    void setEnabled(bool shouldBeEnabled);
+
+    // Returns whether blocks are being measured
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Sets the budget of the current block and latches the enabled flag for it, called at the
+    // start of processBlock before any stage is timed
+    void beginBlock(int numSamples, double sampleRate);
+
+    // Returns whether the current block is measured, only valid on the audio thread
+    bool isMeasuringBlock() const { return measuringBlock; }
+
+    // Counts the time of one stage of the current block, called on the audio thread
+    void addStageTime(Stage stage, juce::int64 ticks);
+
+    // Returns the counts of a stage since the profiler was created. They wrap around, so
+    // periods are measured as the difference between two readings.
+    Histogram getHistogram(Stage stage) const;
+
+    // Returns the upper edge of a bucket in percent of the budget, infinite for the last one
+    static double getBucketUpperPercent(int bucket);
+
+    // Computes the statistics since the previous summary, called from the message thread
+    Summary takeSummary();
+
+    // Returns the name of a stage as shown by the HUD and the trace
+    static const char* getStageName(Stage stage);
+
+private:
+    // Counts and total share of the budget of one stage, written by the audio thread only
+    struct StageCounts
+    {
+        std::array<std::atomic<juce::uint32>, numBuckets> buckets {}; // Blocks counted in each bucket
+        std::atomic<double> percentSum { 0.0 }; // Sum of the shares of the budget
+    };
+
+    // Returns the bucket of a share of the budget
+    int getBucket(double percent) const;
+
+    std::atomic<bool> enabled { false }; // Flag indicating that blocks are measured
+    std::atomic<double> budgetMs { 0.0 }; // Budget of the latest block, for the HUD
+    std::array<StageCounts, numStages> stages; // Counts of each stage
+    std::array<double, numBuckets - 1> upperEdges {}; // Upper edge of every bucket but the last, in percent
+    double ticksPerSecond = 1.0; // Frequency of the high-resolution clock
+    double percentPerTick = 0.0; // Share of the budget of the current block per clock tick
+    bool measuringBlock = false; // Enabled flag latched for the current block
+
+    // State of the previous summary, only used on the message thread
+    std::array<Histogram, numStages> previousHistograms {}; // Counts at the previous summary
+    std::array<double, numStages> previousPercentSums {}; // Sums of the shares at the previous summary
+};
+
+//==============================================================================
+// Counts the time between its construction and destruction in a stage of the profiler,
+// and records it as an audio event of the trace. It does not read the clock while the
+// current block is not measured.
+struct ScopedStageTimer
+{
+    ScopedStageTimer(BlockProfiler& profilerInput, BlockProfiler::Stage stageInput) :
+        profiler(profilerInput),
+        stage(stageInput),
+        startTicks(profilerInput.isMeasuringBlock() ? juce::Time::getHighResolutionTicks() : 0),
+        traceEvent("audio", BlockProfiler::getStageName(stageInput))
+    {
+    }
+
+    ~ScopedStageTimer()
+    {
+        if (startTicks != 0)
+            profiler.addStageTime(stage, juce::Time::getHighResolutionTicks() - startTicks);
+    }
+
+private:
+    BlockProfiler& profiler; // Profiler receiving the time
+    const BlockProfiler::Stage stage; // Stage the time is counted in
+    const juce::int64 startTicks; // Clock at construction, 0 while the block is not measured
+    ScopedTraceEvent traceEvent; // Event of the trace covering the same time
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedStageTimer)
+};
@@ -0,0 +1,123 @@
+#include "PaintProfiler.h"
+
+//==============================================================================
+// Implementation for the PaintProfiler class
+void PaintProfiler::setEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled && !enabled)
+    {
+        frameStartTicks = 0;
+        writeIndex = 0;
+        numFrames = 0;
+        sectionTicks.fill(0);
+        framesSinceSummary = 0;
+        lastExpectedIntervalMs = 0.0;
+        droppedFrames = 0;
+    }
+
+    enabled = shouldBeEnabled;
+}
+
+void PaintProfiler::beginFrame()
+{
+    if (enabled)
+        frameStartTicks = juce::Time::getHighResolutionTicks();
+}
+
+void PaintProfiler::endFrame()
+{
+    if (!enabled || frameStartTicks == 0)
+        return;
+
+    const auto endTicks = juce::Time::getHighResolutionTicks();
+    frameTimesMs[static_cast<size_t>(writeIndex)] = juce::Time::highResolutionTicksToSeconds(endTicks - frameStartTicks) * 1000.0;
+    frameStartsMs[static_cast<size_t>(writeIndex)] = juce::Time::highResolutionTicksToSeconds(frameStartTicks) * 1000.0;
+    writeIndex = (writeIndex + 1) % historySize;
+    numFrames = juce::jmin(numFrames + 1, historySize);
+    ++framesSinceSummary;
+    frameStartTicks = 0;
+}
+
+void PaintProfiler::addPaintTime(Section section, juce::int64 ticks)
+{
+    sectionTicks[static_cast<size_t>(section)] += ticks;
+}
+
+void PaintProfiler::noteTimerTick(double expectedIntervalMs)
+{
+    if (!enabled)
+        return;
+
+    // Ticks right after a change of the frame rate are not compared with the new interval
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    if (expectedIntervalMs == lastExpectedIntervalMs)
+    {
+        const int missed = juce::roundToInt((now - lastTickMs) / expectedIntervalMs) - 1;
+        droppedFrames += juce::jmax(0, missed);
+    }
+
+    lastTickMs = now;
+    lastExpectedIntervalMs = expectedIntervalMs;
+}
+
+PaintProfiler::Summary PaintProfiler::takeSummary()
+{
+    Summary summary;
+
+    if (numFrames > 1)
+    {
+        // The oldest frame of a full history is the one about to be overwritten
+        const int oldest = numFrames < historySize ? 0 : writeIndex;
+        const int newest = (writeIndex + historySize - 1) % historySize;
+        const double spanMs = frameStartsMs[static_cast<size_t>(newest)] - frameStartsMs[static_cast<size_t>(oldest)];
+        if (spanMs > 0.0)
+            summary.framesPerSecond = (numFrames - 1) * 1000.0 / spanMs;
+    }
+
+    if (numFrames > 0)
+    {
+        std::array<double, historySize> sorted = frameTimesMs;
+        std::sort(sorted.begin(), sorted.begin() + numFrames);
+
+        auto percentile = [&sorted, this](double proportion)
+        {
+            return sorted[static_cast<size_t>(juce::jlimit(0, numFrames - 1, static_cast<int>(proportion * numFrames)))];
+        };
+
+        summary.frameTimesMs = { percentile(0.5), percentile(0.95), percentile(0.99), sorted[static_cast<size_t>(numFrames - 1)] };
+    }
+
+    if (framesSinceSummary > 0)
+    {
+        for (int section = 0; section < numSections; ++section)
+        {
+            summary.sectionMs[static_cast<size_t>(section)] =
+                juce::Time::highResolutionTicksToSeconds(sectionTicks[static_cast<size_t>(section)]) * 1000.0 / framesSinceSummary;
+        }
+    }
+
+    summary.droppedFrames = droppedFrames;
+
+    sectionTicks.fill(0);
+    framesSinceSummary = 0;
+    return summary;
+}
+
+const char* PaintProfiler::getSectionName(Section section)
+{
+    switch (section)
+    {
+        case Editor: return "Editor";
+        case Meters: return "Meters";
+        case Multiband: return "Multiband";
+        case Spectrum: return "Spectrum";
+        case Goniometer: return "Goniometer";
+        case Histograms: return "Histograms";
+        case Correlation: return "Correlation";
+        case Statistics: return "Statistics";
+        case Controls: return "Controls";
+        case numSections: break;
+    }
+
+    return "";
+}
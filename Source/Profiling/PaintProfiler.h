@@ -0,0 +1,105 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "TraceRecorder.h"
+
+//==============================================================================
+// Paint cost of the editor, measured while the profiler HUD is shown. A frame is one
+// paint pass of the editor, from the start of its paint to the end of its
+// paintOverChildren, which JUCE calls around the children for every repainted area.
+// The views time their own paint methods with a ScopedPaintTimer, and the totals are
+// grouped by section. The profiler is shared by every open editor through a
+// juce::SharedResourcePointer and is only used on the message thread.
+struct PaintProfiler
+{
+    // Groups of views whose paint time is reported together
+    enum Section
+    {
+        Editor, // Background of the editor
+        Meters, // Peak, RMS and loudness meters with their scales and text meters
+        Multiband, // Multiband level and correlation rows
+        Spectrum, // Spectrum and RTA view with its grid
+        Goniometer, // Goniometer in every mode
+        Histograms, // Level histories and distributions
+        Correlation, // Correlation meter
+        Statistics, // Statistics panel
+        Controls, // Goniometer scale knob
+        numSections
+    };
+
+    static constexpr int historySize = 128; // Frames kept for the frame rate and the percentiles
+    static constexpr double budgetMs = 1000.0 / 60.0; // Frame budget at the full frame rate
+
+    // Statistics of the recent frames, taken by the HUD
+    struct Summary
+    {
+        double framesPerSecond = 0.0; // Paint passes per second over the history
+        std::array<double, 4> frameTimesMs {}; // 50th, 95th and 99th percentile and maximum paint time of a frame
+        std::array<double, numSections> sectionMs {}; // Mean paint time per frame of each section since the previous summary
+        int droppedFrames = 0; // Timer ticks missed since the profiler was enabled
+    };
+
+    // Starts or stops measuring, starting clears the statistics
+    void setEnabled(bool shouldBeEnabled);
+
+    // Returns whether paint times are being measured
+    bool isEnabled() const { return enabled; }
+
+    // Marks the start and the end of a paint pass, called from the paint and paintOverChildren of the editor
+    void beginFrame();
+    void endFrame();
+
+    // Adds the time of one paint call to a section
+    void addPaintTime(Section section, juce::int64 ticks);
+
+    // Counts the frames missed when the timer ticks later than its interval, called on every editor timer tick
+    void noteTimerTick(double expectedIntervalMs);
+
+    // Computes the statistics and starts a new period for the section means
+    Summary takeSummary();
+
+    // Returns the name of a section as shown by the HUD and the trace
+    static const char* getSectionName(Section section);
+
+private:
+    bool enabled = false; // Flag indicating that paint times are measured
+    juce::int64 frameStartTicks = 0; // Start of the current paint pass, 0 outside of one
+    std::array<double, historySize> frameTimesMs {}; // Paint time of the recent frames
+    std::array<double, historySize> frameStartsMs {}; // Start time of the recent frames
+    int writeIndex = 0; // Index of the history that receives the next frame
+    int numFrames = 0; // Number of valid frames in the history
+    std::array<juce::int64, numSections> sectionTicks {}; // Paint time of each section since the previous summary
+    int framesSinceSummary = 0; // Number of frames since the previous summary
+    double lastTickMs = 0.0; // Time of the previous timer tick
+    double lastExpectedIntervalMs = 0.0; // Timer interval at the previous tick
+    int droppedFrames = 0; // Timer ticks missed since the profiler was enabled
+};
+
+//==============================================================================
+// Adds the time between its construction and destruction to a section of the profiler,
+// and records it as a paint event of the trace. It does not read the clock while the
+// profiler is disabled.
+struct ScopedPaintTimer
+{
+    ScopedPaintTimer(PaintProfiler& profilerInput, PaintProfiler::Section sectionInput) :
+        profiler(profilerInput),
+        section(sectionInput),
+        startTicks(profilerInput.isEnabled() ? juce::Time::getHighResolutionTicks() : 0),
+        traceEvent("paint", PaintProfiler::getSectionName(sectionInput))
+    {
+    }
+
+    ~ScopedPaintTimer()
+    {
+        if (startTicks != 0)
+            profiler.addPaintTime(section, juce::Time::getHighResolutionTicks() - startTicks);
+    }
+
+private:
+    PaintProfiler& profiler; // Profiler receiving the time
+    const PaintProfiler::Section section; // Section the time is added to
+    const juce::int64 startTicks; // Clock at construction, 0 while the profiler is disabled
+    ScopedTraceEvent traceEvent; // Event of the trace covering the same time
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedPaintTimer)
+};
@@ -0,0 +1,117 @@
+#include "ProfilerOverlay.h"
+
+//==============================================================================
+// Implementation for the ProfilerOverlay class
+ProfilerOverlay::ProfilerOverlay(MultiMeterAudioProcessor& processor) :
+    blockProfiler(processor.blockProfiler)
+{
+    setInterceptsMouseClicks(false, false);
+
+    // Sample FIFOs between the audio thread and the GUI, and the ring feeding the analysis thread
+    const int capacity = FifoSpectrumAnalyzer<MultiMeterAudioProcessor::BlockType>::getCapacity();
+    fifos.push_back({ "Spectrum L", [&processor] { return processor.leftChannelFifo.getNumCompleteBuffersAvailable(); }, capacity });
+    fifos.push_back({ "Spectrum R", [&processor] { return processor.rightChannelFifo.getNumCompleteBuffersAvailable(); }, capacity });
+    fifos.push_back({ "Statistics", [&processor] { return processor.signalStatistics.getNumSnapshotsAvailable(); }, capacity });
+    fifos.push_back({ "RTA", [&processor] { return processor.realTimeAnalyzer.getNumFramesAvailable(); }, capacity });
+    fifos.push_back({ "Goniometer", [&processor] { return processor.goniometerStream.getNumFramesAvailable(); }, capacity });
+    fifos.push_back({ "Analysis ring", [&processor] { return processor.analysisThread.getNumQueuedFrames(); }, AnalysisThread::ringCapacity });
+
+    refresh();
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    if (isVisible())
+    {
+        profiler->setEnabled(false);
+        blockProfiler.setEnabled(false);
+    }
+}
+
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::black.withAlpha(0.75f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4);
+
+    g.setColour(juce::Colours::white);
+    g.setFont(font);
+    auto area = getLocalBounds().reduced(6, 4);
+    for (const auto& line : lines)
+        g.drawText(line, area.removeFromTop(lineHeight), juce::Justification::centredLeft, false);
+}
+
+void ProfilerOverlay::setActive(bool shouldBeActive)
+{
+    profiler->setEnabled(shouldBeActive);
+    blockProfiler.setEnabled(shouldBeActive);
+    for (auto& fifo : fifos)
+        fifo.peak = 0;
+
+    lastRefreshMs = juce::Time::getMillisecondCounterHiRes();
+    setVisible(shouldBeActive);
+}
+
+void ProfilerOverlay::update(double expectedIntervalMs)
+{
+    profiler->noteTimerTick(expectedIntervalMs);
+
+    // The GUI drains the FIFOs later in the tick, so this is the fill that built up over one frame
+    for (auto& fifo : fifos)
+        fifo.peak = juce::jmax(fifo.peak, fifo.getNumReady());
+
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    if (now - lastRefreshMs >= refreshIntervalMs)
+    {
+        lastRefreshMs = now;
+        refresh();
+        repaint();
+    }
+}
+
+juce::Rectangle<int> ProfilerOverlay::getPreferredSize() const
+{
+    // Two lines for the frames, a heading and a line per section, two headings and a line per
+    // stage, and a heading and a line per FIFO
+    const int numLines = 2 + 1 + PaintProfiler::numSections + 2 + BlockProfiler::numStages + 1 + static_cast<int>(fifos.size());
+    return { 290, numLines * lineHeight + 8 };
+}
+
+void ProfilerOverlay::refresh()
+{
+    const auto summary = profiler->takeSummary();
+    auto ms = [](double value) { return juce::String(value, 2) + " ms"; };
+
+    lines.clearQuick();
+    lines.add("FPS " + juce::String(summary.framesPerSecond, 1) + "   dropped " + juce::String(summary.droppedFrames));
+    lines.add("Frame p50 " + juce::String(summary.frameTimesMs[0], 2) + " p95 " + juce::String(summary.frameTimesMs[1], 2)
+        + " p99 " + juce::String(summary.frameTimesMs[2], 2) + " max " + ms(summary.frameTimesMs[3]));
+
+    lines.add("Paint per frame, share of " + ms(PaintProfiler::budgetMs));
+    for (int section = 0; section < PaintProfiler::numSections; ++section)
+    {
+        const double sectionMs = summary.sectionMs[static_cast<size_t>(section)];
+        lines.add("  " + juce::String(PaintProfiler::getSectionName(static_cast<PaintProfiler::Section>(section))).paddedRight(' ', 12)
+            + ms(sectionMs).paddedLeft(' ', 9) + juce::String(100.0 * sectionMs / PaintProfiler::budgetMs, 1).paddedLeft(' ', 7) + " %");
+    }
+
+    // Percentiles are the upper edges of the histogram buckets they fall in
+    const auto blocks = blockProfiler.takeSummary();
+    auto percent = [](double value) { return (std::isinf(value) ? juce::String(">200") : juce::String(value, 1)).paddedLeft(' ', 7); };
+
+    lines.add("Audio per block, share of " + ms(blocks.budgetMs) + ", " + juce::String(blocks.overBudgetBlocks)
+        + " of " + juce::String(blocks.numBlocks) + " over");
+    lines.add("  " + juce::String("%").paddedRight(' ', 14) + "   mean    p50    p99    max");
+    for (int stage = 0; stage < BlockProfiler::numStages; ++stage)
+    {
+        const auto& summary = blocks.stages[static_cast<size_t>(stage)];
+        lines.add("  " + juce::String(BlockProfiler::getStageName(static_cast<BlockProfiler::Stage>(stage))).paddedRight(' ', 14)
+            + percent(summary.meanPercent) + percent(summary.p50Percent) + percent(summary.p99Percent) + percent(summary.maxPercent));
+    }
+
+    lines.add("FIFO peak fill");
+    for (auto& fifo : fifos)
+    {
+        lines.add("  " + fifo.name.paddedRight(' ', 14) + (juce::String(fifo.peak) + " / " + juce::String(fifo.capacity)).paddedLeft(' ', 13));
+        fifo.peak = 0;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PaintProfiler.h"
+#include "../PluginProcessor.h"
+
+//==============================================================================
+// Profiler HUD drawn over the editor, toggled from the keyboard. It shows the frame rate,
+// percentiles of the paint time per frame, the mean paint time of every section against
+// the frame budget, the number of dropped frames, the cost of processBlock and its stages
+// against the block budget and the highest fill of the FIFOs between the audio, analysis
+// and GUI threads since the previous refresh. It refreshes a few times
+// per second and lets mouse clicks through to the views below it.
+struct ProfilerOverlay : juce::Component
+{
+    static constexpr double refreshIntervalMs = 250.0; // Time between refreshes of the text
+    static constexpr int lineHeight = 13; // Height of a line of text
+
+    // Constructor with the processor owning the FIFOs and the block profiler
+    explicit ProfilerOverlay(MultiMeterAudioProcessor& processor);
+
+    // Destructor, stops the measurements if the HUD is shown
+    ~ProfilerOverlay() override;
+
+    // Paints the text over a translucent background
+    void paint(juce::Graphics& g) override;
+
+    // Shows or hides the HUD and starts or stops the measurements
+    void setActive(bool shouldBeActive);
+
+    // Samples the FIFO fills and counts late timer ticks, and refreshes the text when it is due.
+    // Called at the start of every editor timer tick while the HUD is shown.
+    void update(double expectedIntervalMs);
+
+    // Returns the size of the HUD
+    juce::Rectangle<int> getPreferredSize() const;
+
+private:
+    // Fill level of one FIFO, sampled on every timer tick
+    struct FifoReading
+    {
+        juce::String name; // Name shown by the HUD
+        std::function<int()> getNumReady; // Returns the number of entries waiting to be read
+        int capacity = 1; // Number of entries the FIFO holds
+        int peak = 0; // Highest fill since the previous refresh
+    };
+
+    // Formats the latest summaries of the profilers and the FIFO peaks into the lines of text
+    void refresh();
+
+    juce::SharedResourcePointer<PaintProfiler> profiler; // Paint times of the views
+    BlockProfiler& blockProfiler; // Audio thread cost of the processor
+    std::vector<FifoReading> fifos; // FIFOs whose fill is shown
+    juce::StringArray lines; // Text of the HUD, one entry per line
+    double lastRefreshMs = 0.0; // Time of the previous refresh
+    const juce::Font font { juce::Font::getDefaultMonospacedFontName(), 11.f, juce::Font::plain }; // Font of the text
+};
@@ -0,0 +1,214 @@
+#include "TraceRecorder.h"
+
+//==============================================================================
+// Implementation for the TraceRecorder class
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+bool TraceRecorder::start(const juce::File& file)
+{
+    if (isRecording())
+        return true;
+
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+    if (stream == nullptr || stream->failedToOpen())
+        return false;
+
+    stream->writeText("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", false, false, nullptr);
+
+    // The rings are allocated here rather than by the threads claiming them, so the audio
+    // thread does not allocate them. Events left over from the previous recording are skipped.
+    for (auto& ring : rings)
+    {
+        if (ring.events == nullptr)
+            ring.events = std::make_unique<Event[]>(static_cast<size_t>(ringCapacity));
+
+        ring.readIndex.store(ring.writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    droppedEvents.store(0, std::memory_order_relaxed);
+    originTicks = juce::Time::getHighResolutionTicks();
+    traceFile = file;
+
+    writer = std::make_unique<Writer>(*this, std::move(stream));
+    writer->startThread();
+    recording.store(true, std::memory_order_release);
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (writer == nullptr)
+        return;
+
+    recording.store(false, std::memory_order_release);
+
+    // The writer drains the rings once more and completes the file before it exits
+    writer->stopThread(2000);
+    writer.reset();
+}
+
+void TraceRecorder::record(const char* category, const char* name, juce::int64 startTicks, juce::int64 endTicks)
+{
+    auto* ring = getThreadRing();
+    if (ring == nullptr)
+    {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto write = ring->writeIndex.load(std::memory_order_relaxed);
+    if (write - ring->readIndex.load(std::memory_order_acquire) >= static_cast<juce::uint32>(ringCapacity))
+    {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[write & (ringCapacity - 1)] = { category, name, startTicks, endTicks };
+    ring->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+juce::File TraceRecorder::getDefaultFile()
+{
+    const auto time = juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S");
+    return juce::File::getSpecialLocation(juce::File::userDesktopDirectory).getChildFile("MultiMeter Trace " + time + ".json");
+}
+
+TraceRecorder::Ring* TraceRecorder::getThreadRing()
+{
+    // A thread that found no free ring tries again with its next event
+    thread_local ThreadRing threadRing;
+    if (threadRing.ring == nullptr)
+        threadRing.ring = claimRing();
+
+    return threadRing.ring;
+}
+
+TraceRecorder::Ring* TraceRecorder::claimRing()
+{
+    for (auto& ring : rings)
+    {
+        bool expected = false;
+        if (!ring.owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            continue;
+
+        // Events of the previous owner still waiting for the writer would be shown under
+        // the new thread, so the ring is only reused once they have been written
+        if (ring.readIndex.load(std::memory_order_acquire) != ring.writeIndex.load(std::memory_order_relaxed))
+        {
+            ring.owned.store(false, std::memory_order_release);
+            continue;
+        }
+
+        // JUCE threads are named after themselves, any other thread running the processor
+        // belongs to the host. The name is copied into the ring, so naming does not allocate.
+        std::memset(ring.threadName, 0, sizeof(ring.threadName));
+        if (auto* thread = juce::Thread::getCurrentThread())
+            thread->getThreadName().copyToUTF8(ring.threadName, sizeof(ring.threadName));
+        else if (juce::MessageManager::existsAndIsCurrentThread())
+            std::strncpy(ring.threadName, "Message thread", sizeof(ring.threadName) - 1);
+        else
+            std::strncpy(ring.threadName, "Host audio thread", sizeof(ring.threadName) - 1);
+
+        // Every owner gets an id of its own, so a reused ring shows up as a new thread
+        ring.threadId.store(nextThreadId.fetch_add(1, std::memory_order_relaxed), std::memory_order_release);
+        return &ring;
+    }
+
+    return nullptr;
+}
+
+//==============================================================================
+// Implementation for the TraceRecorder::ThreadRing class
+TraceRecorder::ThreadRing::~ThreadRing()
+{
+    if (ring != nullptr)
+        ring->owned.store(false, std::memory_order_release);
+}
+
+//==============================================================================
+// Implementation for the TraceRecorder::Writer class
+TraceRecorder::Writer::Writer(TraceRecorder& recorderInput, std::unique_ptr<juce::FileOutputStream> streamInput) :
+    juce::Thread("MultiMeter Trace Writer"),
+    recorder(recorderInput),
+    stream(std::move(streamInput))
+{
+}
+
+void TraceRecorder::Writer::run()
+{
+    while (!threadShouldExit())
+    {
+        drain();
+        wait(writeIntervalMs);
+    }
+
+    // Events finished before recording stopped are still in the rings
+    drain();
+
+    // The dropped events are reported as a counter at the end of the trace
+    const auto endMicroseconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - recorder.originTicks) * 1.0e6;
+    stream->writeText(juce::String(firstEvent ? "" : ",\n")
+        + "{\"name\":\"Dropped events\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" + juce::String(endMicroseconds, 3)
+        + ",\"args\":{\"count\":" + juce::String(recorder.droppedEvents.load(std::memory_order_relaxed)) + "}}\n]}\n",
+        false, false, nullptr);
+    stream->flush();
+}
+
+void TraceRecorder::Writer::drain()
+{
+    const double microsecondsPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    juce::MemoryOutputStream text;
+    auto separate = [this, &text]
+    {
+        if (!firstEvent)
+            text << ",\n";
+        firstEvent = false;
+    };
+
+    for (int index = 0; index < maxThreads; ++index)
+    {
+        auto& ring = recorder.rings[static_cast<size_t>(index)];
+        const int threadId = ring.threadId.load(std::memory_order_acquire);
+        if (threadId == 0)
+            continue;
+
+        // Host threads can have any name, so it is escaped
+        auto& namedThreadId = namedThreadIds[static_cast<size_t>(index)];
+        if (namedThreadId != threadId)
+        {
+            namedThreadId = threadId;
+            separate();
+            text << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+                 << ",\"args\":{\"name\":\"" << juce::JSON::escapeString(juce::String::fromUTF8(ring.threadName)) << "\"}}";
+        }
+
+        const auto write = ring.writeIndex.load(std::memory_order_acquire);
+        auto read = ring.readIndex.load(std::memory_order_relaxed);
+        for (; read != write; ++read)
+        {
+            const auto& event = ring.events[read & (ringCapacity - 1)];
+            separate();
+            text << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId
+                 << ",\"ts\":" << juce::String((event.startTicks - recorder.originTicks) * microsecondsPerTick, 3)
+                 << ",\"dur\":" << juce::String((event.endTicks - event.startTicks) * microsecondsPerTick, 3) << "}";
+        }
+
+        ring.readIndex.store(read, std::memory_order_release);
+    }
+
+    if (text.getDataSize() > 0)
+    {
+        stream->write(text.getData(), text.getDataSize());
+        stream->flush();
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Compiles the trace points in, set it to false to remove them entirely
+#ifndef ENABLE_TRACING
+ #define ENABLE_TRACING true
+#endif
+
+//==============================================================================
+// Records timed events from the audio, analysis and message threads and writes them to a
+// file in the Chrome trace event format, which chrome://tracing and Perfetto open. Every
+// thread that records an event claims a ring of its own the first time, so a ring has a
+// single writer and a single reader and no thread waits for another. The ring is handed
+// back when the thread exits, so restarted and recycled threads do not run out of rings.
+// A background thread drains the rings into the file a few times per second. While
+// nothing is recorded, a trace point only loads a flag. Event names must be string
+// literals, as only their pointers are stored.
+struct TraceRecorder
+{
+    static constexpr int maxThreads = 16; // Threads that can own a ring at once, events of further threads are dropped
+    static constexpr int ringCapacity = 8192; // Events held by each ring, a power of two
+    static constexpr int writeIntervalMs = 100; // Time between two drains of the rings
+
+    // One timed event, written as a complete event of the trace
+    struct Event
+    {
+        const char* category = nullptr; // Category shown and filtered by the viewer
+        const char* name = nullptr; // Name of the event
+        juce::int64 startTicks = 0; // High-resolution clock at the start
+        juce::int64 endTicks = 0; // High-resolution clock at the end
+    };
+
+    // Returns the recorder shared by every instance of the plugin
+    static TraceRecorder& getInstance();
+
+    // Destructor, stops recording
+    ~TraceRecorder();
+
+    // Starts recording into a file, replacing it. Returns false if the file cannot be written.
+    bool start(const juce::File& file);
+
+    // Stops recording and completes the file
+    void stop();
+
+    // Returns whether events are being recorded
+    static bool isRecording() { return recording.load(std::memory_order_acquire); }
+
+    // Returns the file of the current or latest recording
+    juce::File getFile() const { return traceFile; }
+
+    // Records an event of the calling thread, dropped if its ring is full
+    void record(const char* category, const char* name, juce::int64 startTicks, juce::int64 endTicks);
+
+    // Returns a new file on the desktop named after the current time
+    static juce::File getDefaultFile();
+
+private:
+    // Events of one thread, written by that thread and read by the writer
+    struct Ring
+    {
+        std::unique_ptr<Event[]> events; // Storage of the events, allocated when recording starts for the first time
+        std::atomic<juce::uint32> writeIndex { 0 }; // Number of events written, wraps around
+        std::atomic<juce::uint32> readIndex { 0 }; // Number of events read, wraps around
+        std::atomic<bool> owned { false }; // Flag indicating that a live thread writes into the ring
+        std::atomic<int> threadId { 0 }; // Id of the latest owner in the trace, 0 until the ring is first claimed
+        char threadName[32] {}; // Name of the latest owner, written before its id is published
+    };
+
+    // Ring of the calling thread, handed back when the thread exits
+    struct ThreadRing
+    {
+        // Destructor, hands the ring back
+        ~ThreadRing();
+
+        Ring* ring = nullptr; // Ring owned by the thread, nullptr until one is claimed
+    };
+
+    // Background thread draining the rings into the file
+    struct Writer : juce::Thread
+    {
+        // Constructor with the recorder and the stream the header has been written to
+        Writer(TraceRecorder& recorderInput, std::unique_ptr<juce::FileOutputStream> streamInput);
+
+        // Drains the rings until the thread is stopped, then completes the file
+        void run() override;
+
+    private:
+        // Writes every waiting event of every ring to the stream
+        void drain();
+
+        TraceRecorder& recorder; // Recorder owning the rings
+        std::unique_ptr<juce::FileOutputStream> stream; // File being written
+        std::array<int, maxThreads> namedThreadIds {}; // Id of the owner of each ring whose name has been written
+        bool firstEvent = true; // Flag indicating that no event has been written yet
+    };
+
+    // Constructor, only used by getInstance
+    TraceRecorder() = default;
+
+    // Returns the ring of the calling thread, claiming one the first time, or nullptr if none is free
+    Ring* getThreadRing();
+
+    // Claims a ring whose previous owner has exited and whose events have all been written
+    Ring* claimRing();
+
+    static inline std::atomic<bool> recording { false }; // Flag indicating that events are recorded
+    std::array<Ring, maxThreads> rings; // Rings of the threads, each owned by at most one live thread
+    std::atomic<int> nextThreadId { 1 }; // Id given to the next thread claiming a ring, 0 holds the counters
+    std::atomic<juce::uint32> droppedEvents { 0 }; // Events lost to full rings or missing rings
+    juce::int64 originTicks = 0; // Clock at the start of the recording, the zero of the trace
+    juce::File traceFile; // File of the current or latest recording
+    std::unique_ptr<Writer> writer; // Thread writing the file while recording
+};
+
+//==============================================================================
+// Records the time between its construction and destruction as an event of the trace.
+// It does not read the clock while nothing is recorded, and it is empty when tracing is
+// compiled out.
+struct ScopedTraceEvent
+{
+#if ENABLE_TRACING
+    ScopedTraceEvent(const char* categoryInput, const char* nameInput) :
+        category(categoryInput),
+        name(nameInput),
+        startTicks(TraceRecorder::isRecording() ? juce::Time::getHighResolutionTicks() : 0)
+    {
+    }
+
+    ~ScopedTraceEvent()
+    {
+        if (startTicks != 0)
+            TraceRecorder::getInstance().record(category, name, startTicks, juce::Time::getHighResolutionTicks());
+    }
+
+private:
+    const char* const category; // Category of the event
+    const char* const name; // Name of the event
+    const juce::int64 startTicks; // Clock at construction, 0 while nothing is recorded
+#else
+    ScopedTraceEvent(const char*, const char*) {}
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedTraceEvent)
+};
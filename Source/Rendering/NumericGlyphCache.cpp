@@ -0,0 +1,76 @@
+#include "NumericGlyphCache.h"
+
+//==============================================================================
+// Implementation for the NumericGlyphCache class
+juce::String NumericGlyphCache::format(float value)
+{
+    if (value <= NEGATIVE_INFINITY)
+        return "-inf";
+
+    // Rounding to tenths first shows small negative values as 0.0 rather than -0.0
+    return juce::String(juce::roundToInt(value * 10.f) / 10.0, 1);
+}
+
+int NumericGlyphCache::getIndex(float value)
+{
+    // Index 0 is "-inf", followed by the tenths from minTenths upwards
+    if (value <= NEGATIVE_INFINITY)
+        return 0;
+
+    const int tenths = juce::roundToInt(value * 10.f);
+    if (tenths < minTenths || tenths > maxTenths)
+        return -1;
+
+    return tenths - minTenths + 1;
+}
+
+void NumericGlyphCache::draw(juce::Graphics& g, float value, const juce::Font& font, juce::Rectangle<int> area, juce::Justification justification)
+{
+    const int index = getIndex(value);
+    if (index < 0)
+    {
+        g.setFont(font);
+        g.drawText(format(value), area, justification, false);
+        return;
+    }
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto& image = getFontSet(font, scale).images[static_cast<size_t>(index)];
+
+    // Render the string the first time it is shown in this font at this scale
+    if (!image.isValid())
+    {
+        const auto text = format(value);
+        const int width = static_cast<int>(std::ceil(font.getStringWidthFloat(text) * scale)) + 2;
+        const int height = static_cast<int>(std::ceil(font.getHeight() * scale));
+
+        image = juce::Image(juce::Image::SingleChannel, width, height, true);
+        juce::Graphics context(image);
+        context.addTransform(juce::AffineTransform::scale(scale));
+        context.setColour(juce::Colours::white);
+        context.setFont(font);
+        context.drawText(text, juce::Rectangle<float>(width / scale, height / scale), juce::Justification::centred, false);
+    }
+
+    // Place the image at its logical size, aligned to physical pixels so it is blitted without resampling
+    const juce::Rectangle<float> size(image.getWidth() / scale, image.getHeight() / scale);
+    auto target = justification.appliedToRectangle(size, area.toFloat());
+    target.setPosition(std::round(target.getX() * scale) / scale, std::round(target.getY() * scale) / scale);
+    g.drawImage(image, target, juce::RectanglePlacement::stretchToFit, true);
+}
+
+NumericGlyphCache::FontSet& NumericGlyphCache::getFontSet(const juce::Font& font, float scale)
+{
+    for (auto& set : fontSets)
+    {
+        if (set.scale == scale && set.font == font)
+            return set;
+    }
+
+    // Moving the editor between displays changes the scale, only the latest few sets are kept
+    if (fontSets.size() >= maxFontSets)
+        fontSets.erase(fontSets.begin());
+
+    fontSets.push_back({ font, scale, std::vector<juce::Image>(static_cast<size_t>(numStrings)) });
+    return fontSets.back();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Constants.h"
+
+//==============================================================================
+// Pre-rendered text of the numbers the meter readouts show: "-inf" and every value from
+// NEGATIVE_INFINITY to MAX_DECIBELS in 0.1 steps. Laying out the text is most of the cost
+// of painting a small readout, so each string is rendered once per font and display scale
+// into an alpha image, and painting only blits that image in the current colour. Values
+// outside the set are drawn as text. The readouts share one cache through a
+// juce::SharedResourcePointer, and it is only used on the message thread.
+struct NumericGlyphCache
+{
+    static constexpr int minTenths = static_cast<int>(NEGATIVE_INFINITY * 10.f); // Lowest cached value in tenths
+    static constexpr int maxTenths = static_cast<int>(MAX_DECIBELS * 10.f); // Highest cached value in tenths
+    static constexpr int numStrings = maxTenths - minTenths + 2; // Every tenth in the range and "-inf"
+    static constexpr size_t maxFontSets = 4; // Fonts and scales kept before the oldest one is dropped
+
+    // Formats a value as the readouts show it, with one decimal, or "-inf" at or below NEGATIVE_INFINITY
+    static juce::String format(float value);
+
+    // Returns the index of the string showing the value, or -1 when the value is not cached
+    static int getIndex(float value);
+
+    // Draws the value within the area in the current colour of the context
+    void draw(juce::Graphics& g, float value, const juce::Font& font, juce::Rectangle<int> area, juce::Justification justification);
+
+private:
+    // Images of the strings for one font at one scale, each rendered when it is first drawn
+    struct FontSet
+    {
+        juce::Font font; // Font of the strings
+        float scale = 1.f; // Physical pixels per logical pixel
+        std::vector<juce::Image> images; // Alpha image of each string, invalid until it is first drawn
+    };
+
+    // Returns the set for the font and scale, creating it when needed
+    FontSet& getFontSet(const juce::Font& font, float scale);
+
+    std::vector<FontSet> fontSets; // Sets in the order they were created
+};
@@ -0,0 +1,170 @@
+#include "PolylineRenderer.h"
+
+//==============================================================================
+// Implementation for the PolylineRenderer class
+void PolylineRenderer::strokePolyline(juce::Image::BitmapData& data, const Polyline& polyline, juce::Colour colour, float thickness)
+{
+    const auto& points = polyline.points;
+    const int numPoints = static_cast<int>(points.size());
+    const auto pixel = colour.getPixelARGB();
+
+    int start = 0;
+    while (start < numPoints)
+    {
+        // Extend the run while the points keep moving in the same horizontal direction
+        int end = start + 1;
+        float direction = 0.f;
+        while (end < numPoints)
+        {
+            const float step = points[static_cast<size_t>(end)].x - points[static_cast<size_t>(end - 1)].x;
+            if (step * direction < 0.f)
+                break;
+
+            if (step != 0.f)
+                direction = step;
+
+            ++end;
+        }
+
+        strokeRun(data, points.data() + start, end - start, pixel, thickness);
+
+        // The next run starts at the turning point
+        if (end >= numPoints)
+            break;
+
+        start = end - 1;
+    }
+}
+
+void PolylineRenderer::strokeLine(juce::Image::BitmapData& data, juce::Point<float> start, juce::Point<float> end, juce::Colour colour, float thickness)
+{
+    const std::array<juce::Point<float>, 2> points { start, end };
+    strokeRun(data, points.data(), 2, colour.getPixelARGB(), thickness);
+}
+
+void PolylineRenderer::strokeRun(juce::Image::BitmapData& data, const juce::Point<float>* points, int numPoints, juce::PixelARGB colour, float thickness)
+{
+    const auto columns = computeSpans(points, numPoints, data.width, thickness / 2.f);
+    for (int x = columns.getStart(); x < columns.getEnd(); ++x)
+    {
+        const auto& span = spans[static_cast<size_t>(x)];
+        blendSpan(data, x, span.top, span.bottom, colour);
+    }
+}
+
+juce::Range<int> PolylineRenderer::computeSpans(const juce::Point<float>* points, int numPoints, int width, float halfThickness)
+{
+    if (numPoints <= 0 || width <= 0)
+        return {};
+
+    if (spans.size() < static_cast<size_t>(width))
+        spans.resize(static_cast<size_t>(width));
+
+    // Columns touched by the points, clipped to the image
+    float minX = points[0].x, maxX = points[0].x;
+    for (int i = 1; i < numPoints; ++i)
+    {
+        minX = juce::jmin(minX, points[i].x);
+        maxX = juce::jmax(maxX, points[i].x);
+    }
+
+    const int firstColumn = juce::jmax(0, static_cast<int>(std::floor(minX)));
+    const int lastColumn = juce::jmin(width - 1, static_cast<int>(std::floor(maxX)));
+    if (firstColumn > lastColumn)
+        return {};
+
+    for (int x = firstColumn; x <= lastColumn; ++x)
+        spans[static_cast<size_t>(x)] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+
+    // Every segment widens the span of each column it crosses by its heights at the column edges
+    auto addSegment = [this, firstColumn, lastColumn](juce::Point<float> a, juce::Point<float> b)
+    {
+        if (a.x > b.x)
+            std::swap(a, b);
+
+        const int begin = juce::jmax(firstColumn, static_cast<int>(std::floor(a.x)));
+        const int end = juce::jmin(lastColumn, static_cast<int>(std::floor(b.x)));
+        const float run = b.x - a.x;
+        const float slope = run > 0.f ? (b.y - a.y) / run : 0.f;
+
+        for (int x = begin; x <= end; ++x)
+        {
+            // A vertical segment covers its whole height in its column
+            const float y0 = run > 0.f ? a.y + (juce::jmax(a.x, static_cast<float>(x)) - a.x) * slope : a.y;
+            const float y1 = run > 0.f ? a.y + (juce::jmin(b.x, static_cast<float>(x + 1)) - a.x) * slope : b.y;
+
+            auto& span = spans[static_cast<size_t>(x)];
+            span.top = juce::jmin(span.top, y0, y1);
+            span.bottom = juce::jmax(span.bottom, y0, y1);
+        }
+    };
+
+    if (numPoints == 1)
+        addSegment(points[0], points[0]);
+
+    for (int i = 1; i < numPoints; ++i)
+        addSegment(points[i - 1], points[i]);
+
+    for (int x = firstColumn; x <= lastColumn; ++x)
+    {
+        auto& span = spans[static_cast<size_t>(x)];
+        span.top -= halfThickness;
+        span.bottom += halfThickness;
+    }
+
+    return { firstColumn, lastColumn + 1 };
+}
+
+void PolylineRenderer::blendSpan(juce::Image::BitmapData& data, int x, float top, float bottom, juce::PixelARGB colour)
+{
+    jassert(data.pixelFormat == juce::Image::ARGB);
+
+    top = juce::jmax(top, 0.f);
+    bottom = juce::jmin(bottom, static_cast<float>(data.height));
+    if (x < 0 || x >= data.width || bottom <= top)
+        return;
+
+    const int firstRow = static_cast<int>(top);
+    const int lastRow = juce::jmin(data.height - 1, static_cast<int>(std::ceil(bottom)) - 1);
+
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        // Fraction of the pixel covered by the span
+        const float coverage = juce::jmin(bottom, static_cast<float>(row + 1)) - juce::jmax(top, static_cast<float>(row));
+        auto* pixel = reinterpret_cast<juce::PixelARGB*>(data.getPixelPointer(x, row));
+
+        if (coverage >= 1.f)
+            pixel->blend(colour);
+        else
+            pixel->blend(colour, static_cast<juce::uint32>(juce::roundToInt(coverage * 255.f)));
+    }
+}
+
+void PolylineRenderer::fillColumn(juce::Image::BitmapData& data, int x, float top, const juce::PixelARGB* rowColours)
+{
+    jassert(data.pixelFormat == juce::Image::ARGB);
+
+    if (x < 0 || x >= data.width || top >= static_cast<float>(data.height))
+        return;
+
+    top = juce::jmax(top, 0.f);
+    const int firstRow = static_cast<int>(top);
+
+    // Only the top pixel is partially covered
+    auto* pixel = reinterpret_cast<juce::PixelARGB*>(data.getPixelPointer(x, firstRow));
+    pixel->blend(rowColours[firstRow], static_cast<juce::uint32>(juce::roundToInt((static_cast<float>(firstRow + 1) - top) * 255.f)));
+
+    for (int row = firstRow + 1; row < data.height; ++row)
+        reinterpret_cast<juce::PixelARGB*>(data.getPixelPointer(x, row))->blend(rowColours[row]);
+}
+
+void PolylineRenderer::clearColumn(juce::Image::BitmapData& data, int x)
+{
+    jassert(data.pixelFormat == juce::Image::ARGB);
+
+    if (x < 0 || x >= data.width)
+        return;
+
+    for (int row = 0; row < data.height; ++row)
+        reinterpret_cast<juce::PixelARGB*>(data.getPixelPointer(x, row))->setARGB(0, 0, 0, 0);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Open polyline in pixel coordinates. It has the subpath interface of juce::Path that
+// AnalyzerPathGenerator uses, but only stores the points, so building one copies them into
+// reused storage instead of creating a path that has to be flattened before it is stroked.
+struct Polyline
+{
+    // Reserves space for the given number of points
+    void preallocateSpace(int numPoints) { points.reserve(static_cast<size_t>(numPoints)); }
+
+    // Starts the polyline at the given point. Only one subpath is kept, so earlier points are dropped.
+    void startNewSubPath(float x, float y) { points.clear(); points.push_back({ x, y }); }
+    void startNewSubPath(juce::Point<float> point) { startNewSubPath(point.x, point.y); }
+
+    // Adds a line from the last point to the given point
+    void lineTo(float x, float y) { points.push_back({ x, y }); }
+    void lineTo(juce::Point<float> point) { lineTo(point.x, point.y); }
+
+    // Removes every point, keeping the storage
+    void clear() { points.clear(); }
+
+    // Returns whether the polyline has no points
+    bool isEmpty() const { return points.empty(); }
+
+    std::vector<juce::Point<float>> points; // Vertices in drawing order
+};
+
+//==============================================================================
+// Antialiased software rasteriser for the curves of the displays, which are all rendered
+// without a GPU. A curve is reduced to one vertical span per pixel column, from the highest
+// to the lowest point it reaches in that column widened by the line thickness, and every
+// span is blended straight into the pixels of an ARGB image, with the partial coverage of
+// its end pixels as the antialiasing. For the thin, mostly horizontal curves of the analyzers
+// this is much cheaper than stroking a juce::Path, which is tessellated into an edge table
+// and allocates on every frame.
+struct PolylineRenderer
+{
+    // Strokes the polyline into an ARGB image with the given colour and thickness in pixels.
+    // The polyline is split where it turns back horizontally, so that every part covers each
+    // column once, and the pixel at a turning point is blended by both parts.
+    void strokePolyline(juce::Image::BitmapData& data, const Polyline& polyline, juce::Colour colour, float thickness = 1.f);
+
+    // Strokes a single line into an ARGB image with the given colour and thickness in pixels
+    void strokeLine(juce::Image::BitmapData& data, juce::Point<float> start, juce::Point<float> end, juce::Colour colour, float thickness = 1.f);
+
+    // Blends the rows from top to bottom of one column of an ARGB image with a premultiplied
+    // colour, covering the end pixels partially
+    static void blendSpan(juce::Image::BitmapData& data, int x, float top, float bottom, juce::PixelARGB colour);
+
+    // Blends the area of one column of an ARGB image below the given top edge, shaded with one
+    // premultiplied colour per row of the image, covering the top pixel partially
+    static void fillColumn(juce::Image::BitmapData& data, int x, float top, const juce::PixelARGB* rowColours);
+
+    // Makes one column of an ARGB image transparent
+    static void clearColumn(juce::Image::BitmapData& data, int x);
+
+private:
+    // Vertical extent covered in one pixel column, in pixels from the top of the image
+    struct ColumnSpan
+    {
+        float top = 0.f; // Upper edge of the span
+        float bottom = 0.f; // Lower edge of the span, above the upper edge for a column that is not covered
+    };
+
+    // Computes the spans of the given points, which must not turn back horizontally, widened by
+    // half the thickness. Returns the range of columns that were computed.
+    juce::Range<int> computeSpans(const juce::Point<float>* points, int numPoints, int width, float halfThickness);
+
+    // Strokes the given points, which must not turn back horizontally
+    void strokeRun(juce::Image::BitmapData& data, const juce::Point<float>* points, int numPoints, juce::PixelARGB colour, float thickness);
+
+    std::vector<ColumnSpan> spans; // Span of every column of the image, reused between curves
+};
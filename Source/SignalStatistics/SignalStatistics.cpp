@@ -0,0 +1,255 @@
+#include "SignalStatistics.h"
+
+//==============================================================================
+// Implementation for the ChannelStatistics class
+void ChannelStatistics::merge(const ChannelStatistics& other)
+{
+    if (other.numSamples == 0)
+        return;
+
+    // The extremes of an empty measurement must not leak into the result
+    min = numSamples > 0 ? juce::jmin(min, other.min) : other.min;
+    max = numSamples > 0 ? juce::jmax(max, other.max) : other.max;
+    sum += other.sum;
+    sumOfSquares += other.sumOfSquares;
+    numSamples += other.numSamples;
+    zeroCrossings += other.zeroCrossings;
+    clipRuns += other.clipRuns;
+}
+
+float ChannelStatistics::getRMS() const
+{
+    return numSamples > 0 ? static_cast<float>(std::sqrt(sumOfSquares / numSamples)) : 0.f;
+}
+
+float ChannelStatistics::getDcOffset() const
+{
+    return numSamples > 0 ? static_cast<float>(sum / numSamples) : 0.f;
+}
+
+//==============================================================================
+// Implementation for the StatisticsSnapshot class
+void StatisticsSnapshot::merge(const StatisticsSnapshot& other)
+{
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+    {
+        channels[channel].merge(other.channels[channel]);
+    }
+
+    timeMs = juce::jmax(timeMs, other.timeMs);
+}
+
+//==============================================================================
+// Implementation for the SignalStatistics class
+void SignalStatistics::prepare(double sampleRate)
+{
+    // One snapshot every 10 ms keeps the FIFO far from full at a 60 Hz frame rate
+    snapshotLength = static_cast<juce::uint32>(juce::jmax(1, juce::roundToInt(sampleRate * 0.01)));
+    msPerSample = 1000.0 / juce::jmax(1.0, sampleRate);
+
+    pending = {};
+    for (auto& history : histories)
+        history.fill(0.f);
+}
+
+void SignalStatistics::process(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(histories.size()));
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto& blockStatistics = lastBlock.channels[channel];
+        analyseBlock(buffer.getReadPointer(channel), numSamples, histories[channel], blockStatistics);
+        pending.channels[channel].merge(blockStatistics);
+    }
+
+    // A mono input is shown on both sides
+    if (numChannels == 1)
+    {
+        lastBlock.channels[1] = lastBlock.channels[0];
+        pending.channels[1] = pending.channels[0];
+    }
+
+    if (pending.channels[0].numSamples >= snapshotLength)
+    {
+        // The snapshot ends with the block, which ends a block duration after it was received
+        pending.timeMs = juce::Time::getMillisecondCounterHiRes() + numSamples * msPerSample;
+        snapshotFifo.push(pending);
+        pending = {};
+    }
+}
+
+void SignalStatistics::analyseBlock(const float* samples,
+    int numSamples,
+    std::array<float, minClipRunLength>& history,
+    ChannelStatistics& statistics)
+{
+    // The kernel keeps independent accumulators per lane and has no branches in its body,
+    // so the compiler can map each lane onto a SIMD register. Every statistic is gathered
+    // from the same load, which replaces the separate peak and RMS passes.
+    constexpr int numLanes = 8;
+
+    if (numSamples <= 0)
+        return;
+
+    std::array<float, numLanes> mins, maxs, sums, squares;
+    std::array<juce::uint32, numLanes> crossings, clipRuns;
+    mins.fill(samples[0]);
+    maxs.fill(samples[0]);
+    sums.fill(0.f);
+    squares.fill(0.f);
+    crossings.fill(0);
+    clipRuns.fill(0);
+
+    auto isFullScale = [](float x) { return static_cast<juce::uint32>(std::abs(x) >= fullScaleThreshold); };
+
+    // Accumulates one sample into a lane given the three samples before it
+    auto accumulate = [&](int lane, float x, float x1, float x2, float x3)
+    {
+        mins[lane] = juce::jmin(mins[lane], x);
+        maxs[lane] = juce::jmax(maxs[lane], x);
+        sums[lane] += x;
+        squares[lane] += x * x;
+        crossings[lane] += static_cast<juce::uint32>((x >= 0.f) != (x1 >= 0.f));
+
+        // A clip is counted once, on the sample where a run reaches minClipRunLength
+        clipRuns[lane] += isFullScale(x) & isFullScale(x1) & isFullScale(x2) & (1u - isFullScale(x3));
+    };
+
+    // The first samples look back into the previous block
+    const int head = juce::jmin(numSamples, minClipRunLength);
+    for (int i = 0; i < head; ++i)
+    {
+        auto previous = [&](int offset) { return i - offset >= 0 ? samples[i - offset] : history[offset - i - 1]; };
+        accumulate(0, samples[i], previous(1), previous(2), previous(3));
+    }
+
+    // Vectorised body, numLanes samples at a time
+    int i = head;
+    for (; i + numLanes <= numSamples; i += numLanes)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const int n = i + lane;
+            accumulate(lane, samples[n], samples[n - 1], samples[n - 2], samples[n - 3]);
+        }
+    }
+
+    // Remaining samples
+    for (; i < numSamples; ++i)
+    {
+        accumulate(0, samples[i], samples[i - 1], samples[i - 2], samples[i - 3]);
+    }
+
+    // Reduce the lanes
+    statistics.min = *std::min_element(mins.begin(), mins.end());
+    statistics.max = *std::max_element(maxs.begin(), maxs.end());
+    statistics.numSamples = static_cast<juce::uint32>(numSamples);
+    statistics.sum = 0.0;
+    statistics.sumOfSquares = 0.0;
+    statistics.zeroCrossings = 0;
+    statistics.clipRuns = 0;
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        statistics.sum += sums[lane];
+        statistics.sumOfSquares += squares[lane];
+        statistics.zeroCrossings += crossings[lane];
+        statistics.clipRuns += clipRuns[lane];
+    }
+
+    // Remember the last samples for the next block, most recent first
+    const auto previousHistory = history;
+    for (int offset = 0; offset < minClipRunLength; ++offset)
+    {
+        const int index = numSamples - 1 - offset;
+        history[offset] = index >= 0 ? samples[index] : previousHistory[offset - numSamples];
+    }
+}
+
+//==============================================================================
+// Implementation for the StatisticsPanel class
+void StatisticsPanel::paint(juce::Graphics& g)
+{
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Statistics);
+
+    // Fill the background with the base color
+    g.setColour(BASE_COLOR);
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4);
+
+    if (readouts.size() < 4)
+        return;
+
+    auto bounds = getLocalBounds().reduced(6, 2);
+    auto topRow = bounds.removeFromTop(bounds.getHeight() / 2);
+    auto columnWidth = bounds.getWidth() / 2;
+
+    g.setColour(HIGHLIGHT_COLOR);
+    g.setFont(11.f);
+    g.drawText(readouts[0], topRow.removeFromLeft(columnWidth), juce::Justification::centredLeft);
+    g.drawText(readouts[1], topRow, juce::Justification::centredLeft);
+    g.drawText(readouts[2], bounds.removeFromLeft(columnWidth), juce::Justification::centredLeft);
+
+    // Clips are highlighted until the panel is reset
+    g.setColour(clipCounts[0] + clipCounts[1] > 0 ? juce::Colours::red : HIGHLIGHT_COLOR);
+    g.drawText(readouts[3], bounds, juce::Justification::centredLeft);
+}
+
+void StatisticsPanel::mouseDown(const juce::MouseEvent& e)
+{
+    programmePeak = 0.f;
+    clipCounts.fill(0);
+    updateReadouts();
+    repaint();
+}
+
+bool StatisticsPanel::updateReadouts()
+{
+    auto& left = latest.channels[0];
+    auto& right = latest.channels[1];
+
+    auto toDecibels = [](float gain) { return juce::Decibels::gainToDecibels(gain, NEGATIVE_INFINITY); };
+    auto crestFactor = [&toDecibels](const ChannelStatistics& s) { return toDecibels(s.getPeak()) - toDecibels(s.getRMS()); };
+    auto crossingRate = [this](const ChannelStatistics& s)
+    {
+        return s.numSamples > 0 ? static_cast<float>(s.zeroCrossings * currentSampleRate / s.numSamples) : 0.f;
+    };
+
+    auto formatPair = [](float l, float r, int decimals) { return juce::String(l, decimals) + " / " + juce::String(r, decimals); };
+
+    auto plr = loudness > NEGATIVE_INFINITY && programmePeak > 0.f ?
+        juce::String(toDecibels(programmePeak) - loudness, 1) + " dB" : juce::String("-");
+
+    juce::StringArray newReadouts;
+    newReadouts.add("DC " + formatPair(left.getDcOffset(), right.getDcOffset(), 3));
+    newReadouts.add("Crest " + formatPair(crestFactor(left), crestFactor(right), 1) + " dB");
+    newReadouts.add("PLR " + plr + "  ZCR " + juce::String(juce::roundToInt((crossingRate(left) + crossingRate(right)) / 2.f)) + " Hz");
+    newReadouts.add("Clips " + juce::String(clipCounts[0]) + " / " + juce::String(clipCounts[1]));
+
+    if (newReadouts == readouts)
+        return false;
+
+    readouts = newReadouts;
+    return true;
+}
+
+void StatisticsPanel::update(const StatisticsSnapshot& frame, double sampleRate, float integratedLoudness)
+{
+    latest = frame;
+    currentSampleRate = sampleRate;
+    loudness = integratedLoudness;
+
+    for (size_t channel = 0; channel < clipCounts.size(); ++channel)
+    {
+        programmePeak = juce::jmax(programmePeak, frame.channels[channel].getPeak());
+        clipCounts[channel] += frame.channels[channel].clipRuns;
+    }
+
+    // Silent or static input gives the same text, which is not repainted
+    if (updateReadouts())
+        repaint();
+}
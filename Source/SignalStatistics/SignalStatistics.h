@@ -0,0 +1,111 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Fifo.h"
+#include "../Constants.h"
+#include "../Profiling/PaintProfiler.h"
+
+//==============================================================================
+// Raw per-channel measurements gathered in a single pass over the samples.
+// Everything else (peak, RMS, DC offset, crest factor) is derived from these.
+struct ChannelStatistics
+{
+    // Combines the measurements of a later stretch of audio into this one
+    void merge(const ChannelStatistics& other);
+
+    // Returns the absolute sample peak as a gain value
+    float getPeak() const { return juce::jmax(std::abs(min), std::abs(max)); }
+
+    // Returns the RMS level as a gain value
+    float getRMS() const;
+
+    // Returns the mean sample value
+    float getDcOffset() const;
+
+    float min = 0.f; // Lowest sample value
+    float max = 0.f; // Highest sample value
+    double sum = 0.0; // Sum of the samples
+    double sumOfSquares = 0.0; // Sum of the squared samples
+    juce::uint32 numSamples = 0; // Number of samples measured
+    juce::uint32 zeroCrossings = 0; // Number of sign changes between consecutive samples
+    juce::uint32 clipRuns = 0; // Number of runs of consecutive full-scale samples
+};
+
+//==============================================================================
+// Measurements of both channels over the same stretch of audio
+struct StatisticsSnapshot
+{
+    // Combines a later snapshot into this one
+    void merge(const StatisticsSnapshot& other);
+
+    std::array<ChannelStatistics, 2> channels;
+    double timeMs = 0.0; // Time of the last sample measured, on the juce::Time::getMillisecondCounterHiRes clock
+};
+
+//==============================================================================
+// Single-pass signal statistics that run on the audio thread. Each block is read
+// once per channel, and the results are published to the GUI through a FIFO
+// of timestamped snapshots covering roughly 10 ms of audio each.
+struct SignalStatistics
+{
+    static constexpr float fullScaleThreshold = 0.999f; // Magnitude treated as full scale
+    static constexpr int minClipRunLength = 3; // Consecutive full-scale samples that count as a clip
+
+    // Prepares the snapshot length for the given sample rate
+    void prepare(double sampleRate);
+
+    // Measures the given buffer, called from processBlock
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Retrieves the oldest snapshot from the FIFO
+    bool getSnapshot(StatisticsSnapshot& snapshot) { return snapshotFifo.pull(snapshot); }
+
+    // Returns the number of snapshots waiting in the FIFO
+    int getNumSnapshotsAvailable() const { return snapshotFifo.getNumAvailableForReading(); }
+
+    // Returns the measurements of the most recent block, only valid on the audio thread
+    const StatisticsSnapshot& getBlockStatistics() const { return lastBlock; }
+
+    // Measures a block of one channel. history holds the last samples of the previous block
+    // of that channel (most recent first) and is updated on return.
+    static void analyseBlock(const float* samples,
+        int numSamples,
+        std::array<float, minClipRunLength>& history,
+        ChannelStatistics& statistics);
+
+private:
+    StatisticsSnapshot pending; // Measurements not yet pushed to the FIFO
+    StatisticsSnapshot lastBlock; // Measurements of the most recent block
+    std::array<std::array<float, minClipRunLength>, 2> histories {}; // Last samples of each channel
+    juce::uint32 snapshotLength = 480; // Number of samples per snapshot
+    double msPerSample = 1000.0 / 48000.0; // Duration of a sample, used for the timestamps
+    FifoSpectrumAnalyzer<StatisticsSnapshot> snapshotFifo; // FIFO for publishing snapshots to the GUI
+};
+
+//==============================================================================
+// Compact QC readout of the signal statistics: DC offset, crest factor,
+// peak-to-loudness ratio, zero-crossing rate and clip count. Clicking it resets
+// the programme peak and the clip counters.
+struct StatisticsPanel : juce::Component
+{
+    // Paints the component
+    void paint(juce::Graphics& g) override;
+
+    // Resets the programme peak and the clip counters when the panel is clicked
+    void mouseDown(const juce::MouseEvent& e) override;
+
+    // Updates the readouts with the statistics of the latest frame, repainting when their text changed
+    void update(const StatisticsSnapshot& frame, double sampleRate, float integratedLoudness);
+
+private:
+    // Formats the readouts from the latest statistics, returns whether any text changed
+    bool updateReadouts();
+
+    juce::StringArray readouts; // Text of the DC, crest factor, PLR and ZCR, and clip readouts
+    StatisticsSnapshot latest; // Statistics of the latest frame
+    double currentSampleRate = 44100.0; // Sample rate used to convert counts to rates
+    float programmePeak = 0.f; // Highest sample peak since the last reset
+    float loudness = NEGATIVE_INFINITY; // Integrated loudness used for the PLR
+    std::array<juce::uint32, 2> clipCounts {}; // Clip runs since the last reset
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
+};
@@ -0,0 +1,160 @@
+#include "RealTimeAnalyzer.h"
+
+//==============================================================================
+// Implementation for the RealTimeAnalyzer class
+float RealTimeAnalyzer::getCentreFrequency(int band)
+{
+    // Base-ten centres 10^(n / 10), where band 0 (n = 13) is the 20 Hz band and band 17 is 1 kHz
+    return 1000.f * std::pow(10.f, static_cast<float>(band - 17) / 10.f);
+}
+
+float RealTimeAnalyzer::getEdgeFrequency(int band, bool upper)
+{
+    return getCentreFrequency(band) * std::pow(10.f, (upper ? 1.f : -1.f) / 20.f);
+}
+
+void RealTimeAnalyzer::prepare(double sampleRate)
+{
+    if (sampleRate <= 0.0)
+        sampleRate = 44100.0;
+
+    const auto decimatorTaps = makeDecimatorTaps();
+    topOctave.prepare(sampleRate, decimatorTaps);
+    for (int octave = 0; octave < maxLowerOctaves; ++octave)
+        lowerOctaves[static_cast<size_t>(octave)].prepare(sampleRate / std::pow(2.0, octave + 1), decimatorTaps);
+
+    // Each band runs in the lowest octave whose quarter rate still holds its upper edge.
+    // Bands reaching Nyquist are left out and stay silent.
+    numLowerOctaves = 0;
+    for (int band = 0; band < numBands; ++band)
+    {
+        const double lowEdge = getEdgeFrequency(band, false);
+        const double highEdge = getEdgeFrequency(band, true);
+        if (highEdge >= sampleRate * 0.49)
+            continue;
+
+        const int octave = juce::jlimit(0, maxLowerOctaves, static_cast<int>(std::floor(std::log2(sampleRate / (4.0 * highEdge)))));
+        if (octave == 0)
+        {
+            topOctave.addBand(band, lowEdge, highEdge);
+        }
+        else
+        {
+            lowerOctaves[static_cast<size_t>(octave - 1)].addBand(band, lowEdge, highEdge);
+            numLowerOctaves = juce::jmax(numLowerOctaves, octave);
+        }
+    }
+
+    currentSampleRate = sampleRate;
+    reset();
+}
+
+void RealTimeAnalyzer::process(const juce::AudioBuffer<float>& buffer)
+{
+    const bool isEnabled = interest.isWanted();
+
+    // Start from silence when the view comes back, instead of from stale filter states
+    if (isEnabled && !wasEnabled)
+        reset();
+    wasEnabled = isEnabled;
+
+    const int numSamples = buffer.getNumSamples();
+    if (!isEnabled || buffer.getNumChannels() == 0 || numSamples == 0)
+        return;
+
+    // The analyzer measures the mid signal, a mono input is used as is
+    auto* left = buffer.getReadPointer(0);
+    auto* right = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
+
+    // Frames are stamped with the time of their last sample, counted from the start of the
+    // block, so frames published by one large block are still spaced a frame apart
+    const int frameLength = juce::jmax(1, juce::roundToInt(currentSampleRate / frameRate.load()));
+    const double blockStartMs = juce::Time::getMillisecondCounterHiRes();
+    const double msPerSample = 1000.0 / currentSampleRate;
+
+    // Each octave runs over a whole chunk before the next one, so its lanes stay in registers.
+    // Chunks end at the frames, whose levels are the integrators at the end of their chunk.
+    int start = 0;
+    while (start < numSamples)
+    {
+        // A frame rate raised since the last frame can leave the count past the frame length
+        const int length = juce::jmin(numSamples - start, chunkLength, juce::jmax(1, frameLength - frameSampleCount));
+        for (int i = 0; i < length; ++i)
+            chunk[static_cast<size_t>(i)] = 0.5f * (left[start + i] + right[start + i]);
+
+        topOctave.process(chunk.data(), length);
+
+        // Every octave keeps one sample out of two of the octave above, so the lower octaves
+        // together cost about as much as the top one
+        int numDecimated = length;
+        for (int octave = 0; octave < numLowerOctaves && numDecimated > 0; ++octave)
+        {
+            auto& lowerOctave = lowerOctaves[static_cast<size_t>(octave)];
+            numDecimated = lowerOctave.decimate(chunk.data(), numDecimated);
+            lowerOctave.process(chunk.data(), numDecimated);
+        }
+
+        start += length;
+        frameSampleCount += length;
+        if (frameSampleCount >= frameLength)
+        {
+            frameSampleCount = 0;
+
+            // Bands reaching Nyquist are in no octave and stay silent
+            std::array<double, numBands> bandMeanSquares {};
+            topOctave.getMeanSquares(bandMeanSquares);
+            for (int octave = 0; octave < numLowerOctaves; ++octave)
+                lowerOctaves[static_cast<size_t>(octave)].getMeanSquares(bandMeanSquares);
+
+            RtaFrame frame;
+            for (int band = 0; band < numBands; ++band)
+            {
+                frame.levels[band] = juce::Decibels::gainToDecibels(static_cast<float>(std::sqrt(bandMeanSquares[band])), NEGATIVE_INFINITY);
+            }
+
+            frame.timeMs = blockStartMs + start * msPerSample;
+            frameFifo.push(frame);
+        }
+    }
+}
+
+RealTimeAnalyzer::DecimatorTaps RealTimeAnalyzer::makeDecimatorTaps()
+{
+    // Windowed sinc with a cut-off at a quarter of the rate, whose taps at even distances
+    // from the centre are 0 and whose centre tap is a half
+    constexpr double beta = 7.0;
+    constexpr int halfLength = (decimatorLength - 1) / 2;
+
+    // Modified Bessel function of the first kind of order 0, as a power series
+    auto bessel = [](double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 30; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    };
+
+    DecimatorTaps taps;
+    for (int tap = 0; tap < numDecimatorTaps; ++tap)
+    {
+        const int distance = 2 * tap + 1;
+        const double ratio = static_cast<double>(distance) / halfLength;
+        const double window = bessel(beta * std::sqrt(1.0 - ratio * ratio)) / bessel(beta);
+        const double sinc = std::sin(juce::MathConstants<double>::halfPi * distance) / (juce::MathConstants<double>::pi * distance);
+        taps[static_cast<size_t>(tap)] = static_cast<float>(sinc * window);
+    }
+
+    return taps;
+}
+
+void RealTimeAnalyzer::reset()
+{
+    topOctave.reset();
+    for (auto& lowerOctave : lowerOctaves)
+        lowerOctave.reset();
+
+    frameSampleCount = 0;
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Fifo.h"
+#include "../Constants.h"
+#include "../DSP/BiquadBank.h"
+#include "../Analysis/ViewInterest.h"
+
+//==============================================================================
+// Band levels of one RTA frame in decibels, from the 20 Hz band to the 20 kHz band
+struct RtaFrame
+{
+    static constexpr int numBands = 31; // 1/3-octave bands from 20 Hz to 20 kHz
+
+    std::array<float, numBands> levels; // RMS level of each band in decibels
+    double timeMs = 0.0; // Time of the last sample measured, on the juce::Time::getMillisecondCounterHiRes clock
+};
+
+//==============================================================================
+// Classic 31-band 1/3-octave real-time analyzer that runs on the audio thread.
+// The mid signal is filtered by order 3 Butterworth band passes at the base-ten
+// centre frequencies of ANSI S1.11 / IEC 61260. The bands are split into octaves that
+// run at their own rate: the bands above an eighth of the sample rate run at full rate,
+// and each lower octave runs at half the rate of the one above, after a half-band low
+// pass. Every band pass thus sits above an eighth of its rate, where single precision is
+// accurate, and the whole bank costs about twice the top octave.
+// The squared outputs feed 125 ms ("fast") one-pole integrators, which are sampled at
+// the analysis rate and published as timestamped RtaFrames, so the GUI only receives
+// 31 floats per frame and can interpolate between them.
+// The analyzer is idle while no view shows it.
+struct RealTimeAnalyzer
+{
+    static constexpr int numBands = RtaFrame::numBands;
+    static constexpr float integrationTimeMs = 125.f; // Time constant of the band integrators
+    static constexpr float defaultFrameRate = 30.f; // Frames published per second unless set otherwise
+
+    // Returns the nominal centre frequency of a band in Hz
+    static float getCentreFrequency(int band);
+
+    // Returns the lower or upper edge frequency of a band in Hz
+    static float getEdgeFrequency(int band, bool upper);
+
+    // Designs the band filters for the given sample rate and clears their state
+    void prepare(double sampleRate);
+
+    // Measures the given buffer while a view shows the RTA, called from processBlock
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Retrieves the oldest frame from the FIFO
+    bool getFrame(RtaFrame& frame) { return frameFifo.pull(frame); }
+
+    // Returns the number of frames waiting in the FIFO
+    int getNumFramesAvailable() const { return frameFifo.getNumAvailableForReading(); }
+
+    // Sets the number of frames published per second, called from the GUI
+    void setFrameRate(float framesPerSecond) { frameRate.store(framesPerSecond); }
+
+    ViewInterest interest; // Views showing the RTA bars
+
+private:
+    static constexpr int filterOrder = 3; // Sections per band
+    static constexpr int topLanes = 8; // Bands at full rate, from an eighth of the sample rate to Nyquist
+    static constexpr int octaveLanes = 4; // Bands of a decimated octave, which spans an eighth to a quarter of its rate
+    static constexpr int maxLowerOctaves = 12; // Halvings of the rate, enough for the 20 Hz band at 384 kHz
+    static constexpr int chunkLength = 256; // Samples run through one octave before moving to the next
+    static constexpr int decimatorLength = 19; // Taps of the half-band anti-alias filter before each halving
+    static constexpr int numDecimatorTaps = (decimatorLength + 1) / 4; // Taps at odd distances from the centre, the others are 0
+
+    using DecimatorTaps = std::array<float, numDecimatorTaps>;
+
+    // Band passes and integrators of the bands that share one rate
+    template<int NumLanes>
+    struct Octave
+    {
+        // Removes every band and sets the rate of the octave and the taps of its decimator
+        void prepare(double sampleRate, const DecimatorTaps& taps)
+        {
+            BiquadCoefficients silence;
+            silence.b0 = 0.0;
+            filters.setCoefficients(0, silence);
+            integratorPole = std::exp(-1000.0 / (integrationTimeMs * sampleRate));
+            decimatorTaps = taps;
+            bands.fill(-1);
+            numUsedLanes = 0;
+            rate = sampleRate;
+        }
+
+        // Measures a band in the next free lane
+        void addBand(int band, double lowEdge, double highEdge)
+        {
+            jassert(numUsedLanes < NumLanes);
+            if (numUsedLanes >= NumLanes)
+                return;
+
+            auto sections = BiquadCoefficients::makeButterworthBandPass(rate, lowEdge, highEdge, filterOrder);
+            for (int stage = 0; stage < filterOrder; ++stage)
+                filters.setCoefficients(stage, numUsedLanes, sections[static_cast<size_t>(stage)]);
+
+            bands[static_cast<size_t>(numUsedLanes++)] = band;
+        }
+
+        // Clears the filter states
+        void reset()
+        {
+            filters.reset();
+            meanSquares.fill(0.0);
+            decimatorHistory.fill(0.f);
+            keepNextSample = true;
+        }
+
+        // Filters samples of the rate above through the half-band low pass and writes every second
+        // one to the start of the buffer, returning how many were kept. Only the kept samples are
+        // computed, and the filter has no feedback, so halving costs a few multiplies per sample.
+        int decimate(float* samples, int numSamples)
+        {
+            // The history holds the last inputs of the previous chunk, followed by this one
+            constexpr int historyLength = decimatorLength - 1;
+            std::copy(samples, samples + numSamples, decimatorHistory.begin() + historyLength);
+
+            const int first = keepNextSample ? 0 : 1;
+            int numKept = 0;
+            for (int i = first; i < numSamples; i += 2)
+            {
+                const float* centre = decimatorHistory.data() + i + historyLength / 2;
+                float y = 0.5f * centre[0];
+                for (int tap = 0; tap < numDecimatorTaps; ++tap)
+                    y += decimatorTaps[static_cast<size_t>(tap)] * (centre[-(2 * tap + 1)] + centre[2 * tap + 1]);
+
+                samples[numKept++] = y;
+            }
+
+            keepNextSample = (numSamples - first) % 2 == 0;
+            std::copy(decimatorHistory.begin() + numSamples, decimatorHistory.begin() + numSamples + historyLength, decimatorHistory.begin());
+            return numKept;
+        }
+
+        // Measures samples at the rate of the octave. The squares are summed over the chunk and
+        // integrated once at its end, which a chunk far shorter than the 125 ms time constant
+        // cannot tell apart from integrating every sample.
+        void process(const float* samples, int numSamples)
+        {
+            if (numSamples == 0)
+                return;
+
+            std::array<float, NumLanes> sums {};
+            for (int i = 0; i < numSamples; ++i)
+            {
+                typename BiquadBank<NumLanes, filterOrder, float>::Frame bandSamples;
+                bandSamples.fill(samples[i]);
+                filters.process(bandSamples);
+
+                for (int lane = 0; lane < NumLanes; ++lane)
+                    sums[lane] += bandSamples[lane] * bandSamples[lane];
+            }
+
+            const double decay = std::pow(integratorPole, numSamples);
+            for (int lane = 0; lane < NumLanes; ++lane)
+                meanSquares[lane] = decay * meanSquares[lane] + (1.0 - decay) * sums[lane] / numSamples;
+        }
+
+        // Writes the latest mean square of every band of the octave
+        void getMeanSquares(std::array<double, numBands>& bandMeanSquares) const
+        {
+            for (int lane = 0; lane < numUsedLanes; ++lane)
+                bandMeanSquares[static_cast<size_t>(bands[static_cast<size_t>(lane)])] = meanSquares[lane];
+        }
+
+        BiquadBank<NumLanes, filterOrder, float> filters; // Band pass filters, one band per lane, unused lanes are silent
+        std::array<double, NumLanes> meanSquares {}; // Integrated mean square of every lane, in double as the pole sits close to 1
+        double integratorPole = 0.0; // Decay of the integrators per sample of the octave
+        DecimatorTaps decimatorTaps {}; // Taps of the half-band filter, unused at full rate
+        std::array<float, chunkLength + decimatorLength - 1> decimatorHistory {}; // Inputs of the half-band filter at the rate above
+        std::array<int, NumLanes> bands {}; // Band measured by each lane, -1 for unused lanes
+        int numUsedLanes = 0; // Number of lanes holding a band
+        double rate = 48000.0; // Sample rate of the octave
+        bool keepNextSample = true; // Phase of the decimation, whether the next sample of the rate above is kept
+    };
+
+    // Returns the taps of a 19-tap half-band low pass with a Kaiser window, flat within 0.01 dB
+    // up to an eighth of its rate and over 70 dB down from three eighths, which alias onto the
+    // bands of the next octave once the rate is halved
+    static DecimatorTaps makeDecimatorTaps();
+
+    // Clears the states of every octave
+    void reset();
+
+    Octave<topLanes> topOctave; // Bands run at full rate
+    std::array<Octave<octaveLanes>, maxLowerOctaves> lowerOctaves; // Octaves at half the rate of the one before
+    int numLowerOctaves = 0; // Lower octaves holding a band, run in order down to the lowest band
+    std::array<float, chunkLength> chunk {}; // Mid signal of the current chunk, decimated in place from octave to octave
+    bool wasEnabled = false; // Whether the previous block was analysed
+    double currentSampleRate = 48000.0; // Sample rate the filters are designed for
+    std::atomic<float> frameRate { defaultFrameRate }; // Frames published per second, set by the GUI
+    int frameSampleCount = 0; // Number of samples since the last frame
+
+    FifoSpectrumAnalyzer<RtaFrame> frameFifo; // FIFO for publishing frames to the GUI
+};
@@ -18,6 +18,8 @@ LogarithmicScale::~LogarithmicScale() {}
 // Overrides the paint function to draw the logarithmic scale
 void LogarithmicScale::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Spectrum);
+
     // Set the grid color
     g.setColour(gridColor);
 
@@ -194,6 +196,8 @@ SpectrumGrid::~SpectrumGrid() {}
 // Overrides the paint function to draw the grid
 void SpectrumGrid::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Spectrum);
+
     // Set the grid color
     g.setColour(gridColor);
     // Draw the grid rectangle
@@ -376,13 +380,18 @@ void SpectrumGrid::addLabels()
 
 //==============================================================================
 // Implementation for the PathProducer class
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+bool PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
 {
+    ScopedTraceEvent traceEvent("analysis", "PathProducer::process");
+
     juce::AudioBuffer<float> tempIncomingBuffer;
+    bool receivedSamples = false;
 
-    // Process available audio buffers in the FIFO
+    // Slide every available audio buffer into the mono buffer, only the latest window is analysed
     while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
     {
+        ScopedTraceEvent pullEvent("fifo", "Spectrum FIFO pull");
+
         // If an audio buffer is available, process it
         if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
         {
@@ -397,30 +406,55 @@ void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
                 tempIncomingBuffer.getReadPointer(0, 0),
                 size);
 
-            // Produce FFT data for rendering
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, -120.f);
+            receivedSamples = true;
         }
     }
 
     const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
     const auto binWidth = sampleRate / double(fftSize);
+    const double displayPeriodMs = 1000.0 / FrameScheduler::fullRateHz;
+    const double now = juce::Time::getMillisecondCounterHiRes();
 
-    // Process available FFT data blocks
-    while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+    // Produce FFT data for rendering at the analysis rate rather than once per incoming buffer,
+    // allowing half a frame of timer jitter
+    if (receivedSamples && now - lastAnalysisMs >= analysisIntervalMs - displayPeriodMs / 2)
     {
-        std::vector<float> fftData;
-        if (leftChannelFFTDataGenerator.getFFTData(fftData))
-        {
-            // Generate path from FFT data
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, -120.f);
-        }
+        leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, -120.f);
+        while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+            leftChannelFFTDataGenerator.getFFTData(fftData);
+
+        spectra.push(fftData, now);
+        lastAnalysisMs = now;
+    }
+
+    if (!spectra.hasFrame())
+        return false;
+
+    // Move between the two latest spectra at the display time
+    const auto& latest = spectra.getLatest();
+    displayedFFTData.resize(latest.size());
+    FrameInterpolator<std::vector<float>>::interpolate(spectra.getPrevious().data(), latest.data(),
+        spectra.getProportion(now, displayPeriodMs), displayedFFTData.data(), static_cast<int>(latest.size()));
+
+    // Silent or static input produces the same data again, which would draw the same path
+    if (displayedFFTData != renderedFFTData || fftBounds != renderedBounds || sampleRate != renderedSampleRate)
+    {
+        renderedFFTData = displayedFFTData;
+        renderedBounds = fftBounds;
+        renderedSampleRate = sampleRate;
+
+        // Generate path from FFT data
+        pathProducer.generatePath(displayedFFTData, fftBounds, fftSize, binWidth, -120.f);
     }
 
     // Retrieve paths from the path producer
+    bool pathChanged = false;
     while (pathProducer.getNumPathsAvailable() > 0)
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        pathChanged = pathProducer.getPath(leftChannelFFTPath) || pathChanged;
     }
+
+    return pathChanged;
 }
 
 //==============================================================================
@@ -440,37 +474,91 @@ rightPathProducer(audioProcessor.rightChannelFifo)
     logGrid.setGridColour(juce::Colour(0xff464646));
     // Set the text color of the grid
     logGrid.setTextColour(juce::Colour(0xff848484));
+
+    // The FFT and the RTA only run on the audio thread while their mode is shown
+    rtaFrame.levels.fill(NEGATIVE_INFINITY);
+    addAndMakeVisible(modeSwitch);
+    modeSwitch.setButtonText("FFT");
+    modeSwitch.onClick = [this]()
+    {
+        visibilityChanged();
+        rtaFrame.levels.fill(NEGATIVE_INFINITY);
+        rtaFrames.reset();
+        repaint();
+    };
+    visibilityChanged();
+}
+
+// Destructor for ResponseCurveComponent, the interest registration is released with it
+ResponseCurveComponent::~ResponseCurveComponent() = default;
+
+// Called when the component is shown or hidden, and when the mode changes
+void ResponseCurveComponent::visibilityChanged()
+{
+    if (!isVisible())
+        interestRegistration.setTarget(nullptr);
+    else if (modeSwitch.getToggleState())
+        interestRegistration.setTarget(&audioProcessor.realTimeAnalyzer.interest);
+    else
+        interestRegistration.setTarget(&audioProcessor.spectrumInterest);
 }
 
 // Paint function for ResponseCurveComponent
 void ResponseCurveComponent::paint(juce::Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Spectrum);
+
     // Fill a rounded rectangle with the background color
     g.setColour(BASE_COLOR);
     g.fillRect(getAnalysisArea());
+
+    // The bars are drawn below the grid so its lines stay visible
+    if (modeSwitch.getToggleState())
+        drawRtaBars(g);
+}
+
+// Function to draw the RTA band levels as bars
+void ResponseCurveComponent::drawRtaBars(juce::Graphics& g)
+{
+    auto area = getAnalysisArea().toFloat();
+
+    // Use the same mappings as the FFT curves so both views share the grid and scale
+    auto mapX = [&area](float frequency)
+    {
+        return area.getX() + juce::jlimit(0.f, 1.f, juce::mapFromLog10(frequency, 20.f, 20000.f)) * area.getWidth();
+    };
+    auto mapY = [&area](float level)
+    {
+        return juce::jmap(juce::jlimit(-120.f, 0.f, level), -120.f, 0.f, area.getBottom(), area.getY());
+    };
+
+    g.setGradientFill(juce::ColourGradient(leftChannelColour, 0.f, area.getY(),
+        leftChannelColour.withAlpha(0.3f), 0.f, area.getBottom(), false));
+
+    for (int band = 0; band < RtaFrame::numBands; ++band)
+    {
+        const auto left = mapX(RealTimeAnalyzer::getEdgeFrequency(band, false)) + 1.f;
+        const auto right = mapX(RealTimeAnalyzer::getEdgeFrequency(band, true)) - 1.f;
+        const auto top = mapY(rtaFrame.levels[band]);
+
+        if (right <= left || top >= area.getBottom())
+            continue;
+
+        g.fillRect(juce::Rectangle<float>(left, top, right - left, area.getBottom() - top));
+    }
 }
 
 // Function to paint over the children of ResponseCurveComponent
 void ResponseCurveComponent::paintOverChildren(Graphics& g)
 {
+    ScopedPaintTimer paintTimer(*paintProfiler, PaintProfiler::Spectrum);
+
     // Get the area for response analysis
     auto responseArea = getAnalysisArea();
 
-    // Get the path for FFT of the right channel
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    // Translate the path to response area
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-    // Set the color and stroke the path
-    g.setColour(rightChannelColour);
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
-
-    // Get the path for FFT of the left channel
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    // Translate the path to response area
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-    // Set the color and stroke the path
-    g.setColour(leftChannelColour);
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+    // The FFT curves are only drawn in FFT mode. They are rasterised in the timer, painting only blits them.
+    if (!modeSwitch.getToggleState() && curveImage.isValid())
+        g.drawImageAt(curveImage, responseArea.getX(), responseArea.getY());
 
     // Create a border path
     Path border;
@@ -488,16 +576,62 @@ void ResponseCurveComponent::paintOverChildren(Graphics& g)
 // Timer callback function for ResponseCurveComponent
 void ResponseCurveComponent::timerCallback()
 {
+    // Nothing is analysed or drawn behind another view
+    if (!isVisible())
+        return;
+
     // Get the bounds for FFT analysis
     auto fftBounds = getAnalysisArea().toFloat();
     // Get the sample rate
     auto sampleRate = audioProcessor.getSampleRate();
 
-    // Process FFT for left and right channels
-    leftPathProducer.process(fftBounds, sampleRate);
-    rightPathProducer.process(fftBounds, sampleRate);
-    // Repaint the component
-    repaint();
+    // Only repaint when the bars or curves changed, so a settled display lets the editor idle
+    bool changed = false;
+    if (modeSwitch.getToggleState())
+    {
+        // The bars move between the two latest RTA frames
+        RtaFrame frame;
+        while (audioProcessor.realTimeAnalyzer.getFrame(frame))
+            rtaFrames.push(frame, frame.timeMs);
+
+        if (rtaFrames.hasFrame())
+        {
+            const auto displayedLevels = rtaFrame.levels;
+            const float proportion = rtaFrames.getProportion(juce::Time::getMillisecondCounterHiRes(), 1000.0 / FrameScheduler::fullRateHz);
+            FrameInterpolator<RtaFrame>::interpolate(rtaFrames.getPrevious().levels.data(), rtaFrames.getLatest().levels.data(),
+                proportion, rtaFrame.levels.data(), RtaFrame::numBands);
+
+            changed = rtaFrame.levels != displayedLevels;
+        }
+    }
+    else
+    {
+        // Process FFT for left and right channels
+        const bool leftChanged = leftPathProducer.process(fftBounds, sampleRate);
+        const bool rightChanged = rightPathProducer.process(fftBounds, sampleRate);
+        changed = leftChanged || rightChanged;
+
+        if (changed)
+            renderCurves();
+    }
+
+    if (changed)
+        repaint();
+}
+
+void ResponseCurveComponent::setAnalysisRate(float framesPerSecond)
+{
+    leftPathProducer.setAnalysisRate(framesPerSecond);
+    rightPathProducer.setAnalysisRate(framesPerSecond);
+    audioProcessor.realTimeAnalyzer.setFrameRate(framesPerSecond);
+}
+
+void ResponseCurveComponent::setIdle(bool shouldIdle)
+{
+    if (shouldIdle)
+        stopTimer();
+    else
+        startTimerHz(FrameScheduler::fullRateHz);
 }
 
 // Resized function for ResponseCurveComponent
@@ -505,6 +639,26 @@ void ResponseCurveComponent::resized()
 {
     // Set the bounds for logGrid
     logGrid.setBounds(getAnalysisArea());
+
+    // Place the mode switch in the top right corner of the analysis area
+    modeSwitch.setBounds(getAnalysisArea().removeFromTop(22).removeFromRight(48).reduced(4));
+
+    // The curves are rasterised again at the new size, as the paths follow the bounds
+    const auto area = getAnalysisArea();
+    curveImage = area.isEmpty() ? juce::Image() : juce::Image(juce::Image::ARGB, area.getWidth(), area.getHeight(), true);
+}
+
+// Function to rasterise the FFT curves of both channels into the curve image
+void ResponseCurveComponent::renderCurves()
+{
+    if (!curveImage.isValid())
+        return;
+
+    // The right channel is drawn first, so the left channel stays on top
+    curveImage.clear(curveImage.getBounds());
+    juce::Image::BitmapData data(curveImage, juce::Image::BitmapData::readWrite);
+    curveRenderer.strokePolyline(data, rightPathProducer.getPath(), rightChannelColour);
+    curveRenderer.strokePolyline(data, leftPathProducer.getPath(), leftChannelColour);
 }
 
 // Function to get the render area
@@ -4,6 +4,11 @@
 #include <JuceHeader.h>
 #include "../Constants.h"
 #include "../PluginProcessor.h"
+#include "../Controls/Buttons.h"
+#include "../Analysis/FrameInterpolator.h"
+#include "../Rendering/PolylineRenderer.h"
+#include "../Profiling/PaintProfiler.h"
+#include "../Profiling/TraceRecorder.h"
 
 //==============================================================================
 // Enumeration FFTOrder
@@ -67,6 +72,8 @@ private:
     // Map to store labels
     std::map<int, std::unique_ptr<juce::Label>> labels;
 
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
+
     // Macro to declare the class as non-copyable with leak detector
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogarithmicScale)
 };
@@ -120,6 +127,8 @@ private:
     // Map to store labels
     std::map<int, std::unique_ptr<juce::Label>> labels;
 
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
+
     // Macro to declare the class as non-copyable with leak detector
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumGrid)
 };
@@ -132,6 +141,8 @@ struct FFTDataGenerator
     // Function to produce FFT data suitable for rendering
     void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
     {
+        ScopedTraceEvent traceEvent("analysis", "FFTDataGenerator");
+
         // Get the FFT size
         const auto fftSize = getFFTSize();
 
@@ -231,10 +242,9 @@ struct AnalyzerPathGenerator
         // Calculate the number of FFT bins
         int numBins = (int)fftSize / 2;
 
-        // Create a new path
-        PathType p;
-        // Preallocate space for the path
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        // Refill the working path, which keeps its storage from the previous curve
+        workingPath.clear();
+        workingPath.preallocateSpace(3 * (int)fftBounds.getWidth());
 
         // Lambda function to map render data to y-coordinates
         auto map = [bottom, top, negativeInfinity](float v)
@@ -247,7 +257,7 @@ struct AnalyzerPathGenerator
         // Check for NaN or infinity
         jassert(!std::isnan(y) && !std::isinf(y));
         // Start a new subpath at (0, y)
-        p.startNewSubPath(0, y);
+        workingPath.startNewSubPath(0, y);
 
         // Define the resolution for the path
         const int pathResolution = 1;
@@ -268,12 +278,12 @@ struct AnalyzerPathGenerator
                 // Calculate the actual x-coordinate in the FFT bounds
                 int binX = std::floor(normalizedBinX * width);
                 // Add a line segment to the path
-                p.lineTo(binX, y);
+                workingPath.lineTo(binX, y);
             }
         }
 
         // Push the generated path to the path FIFO
-        pathFifo.push(p);
+        pathFifo.push(workingPath);
     }
 
     // Function to get the number of paths available in the FIFO
@@ -289,6 +299,9 @@ struct AnalyzerPathGenerator
     }
 
 private:
+    // Path the curve is built in, reused so no storage is allocated once it has grown
+    PathType workingPath;
+
     // FIFO for storing generated paths
     FifoSpectrumAnalyzer<PathType> pathFifo;
 };
@@ -307,11 +320,15 @@ struct PathProducer
         monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
     }
 
-    // Function to process FFT data
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
+    // Function to process FFT data, returns whether the path changed. Only the latest window is
+    // analysed, at most at the analysis rate, and the path moves between the two latest spectra.
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate);
+
+    // Function to get the path, in pixels relative to the analysis area
+    const Polyline& getPath() const { return leftChannelFFTPath; }
 
-    // Function to get the path
-    juce::Path getPath() { return leftChannelFFTPath; }
+    // Function to set the number of spectra analysed per second
+    void setAnalysisRate(float spectraPerSecond) { analysisIntervalMs = 1000.0 / spectraPerSecond; }
 
 private:
     // Pointer to the single channel sample FIFO
@@ -320,10 +337,22 @@ private:
     juce::AudioBuffer<float> monoBuffer;
     // FFT data generator for the left channel
     FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
-    // Path generator for analyzer
-    AnalyzerPathGenerator<juce::Path> pathProducer;
+    // Path generator for analyzer, producing the points of the curve without building a juce::Path
+    AnalyzerPathGenerator<Polyline> pathProducer;
     // Path for the FFT of the left channel
-    juce::Path leftChannelFFTPath;
+    Polyline leftChannelFFTPath;
+    // Latest spectrum of the FFT data generator, and the two latest spectra with their analysis times
+    std::vector<float> fftData;
+    FrameInterpolator<std::vector<float>> spectra;
+    // Time between analyses and time of the latest analysis in milliseconds
+    double analysisIntervalMs = 1000.0 / 30.0;
+    double lastAnalysisMs = 0.0;
+    // Spectrum interpolated for the current frame
+    std::vector<float> displayedFFTData;
+    // FFT data, bounds and sample rate the path was generated from, so unchanged data is not drawn again
+    std::vector<float> renderedFFTData;
+    juce::Rectangle<float> renderedBounds;
+    double renderedSampleRate = 0.0;
 };
 
 //==============================================================================
@@ -334,6 +363,9 @@ struct ResponseCurveComponent : juce::Component,
     // Constructor
     ResponseCurveComponent(MultiMeterAudioProcessor&);
 
+    // Destructor
+    ~ResponseCurveComponent() override;
+
     // Overrides the paint function to draw the component
     void paint(juce::Graphics&) override;
 
@@ -346,6 +378,15 @@ struct ResponseCurveComponent : juce::Component,
     // Overrides the resized function to handle resizing of the component
     void resized() override;
 
+    // Registers interest in the analysis of the current mode while the component is visible
+    void visibilityChanged() override;
+
+    // Stops the analysis and drawing while the editor is idle, the settled display stays as it is
+    void setIdle(bool shouldIdle);
+
+    // Sets the number of FFT spectra and RTA frames analysed per second, independently of the frame rate
+    void setAnalysisRate(float framesPerSecond);
+
 private:
     // Reference to the audio processor
     MultiMeterAudioProcessor& audioProcessor;
@@ -366,6 +407,28 @@ private:
     // Function to get the area for analysis
     juce::Rectangle<int> getAnalysisArea();
 
+    // Function to draw the RTA band levels as bars
+    void drawRtaBars(juce::Graphics& g);
+
+    // Function to rasterise the FFT curves of both channels into the curve image
+    void renderCurves();
+
     // Path producers for left and right channels
     PathProducer leftPathProducer, rightPathProducer;
+
+    // FFT curves of both channels over the analysis area, rasterised only when they change
+    juce::Image curveImage;
+    PolylineRenderer curveRenderer;
+
+    // Switches between the FFT curves and the 1/3-octave RTA bars
+    Switch modeSwitch { "RTA", "FFT" };
+
+    // Registration with the FFT or RTA analysis, released when hidden or destroyed
+    InterestRegistration interestRegistration;
+
+    // Two latest RTA frames with their timestamps, and the band levels drawn between them
+    FrameInterpolator<RtaFrame> rtaFrames;
+    RtaFrame rtaFrame;
+
+    juce::SharedResourcePointer<PaintProfiler> paintProfiler; // Paint times shown by the profiler HUD
 };